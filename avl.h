@@ -5,40 +5,117 @@
 #ifndef AVL_H
 #define AVL_H
 #include "binarytree.h"
+#include "eytzinger.h"
 #include <vector>
 namespace ds {
-class AVL : public BinaryTree {
+template <typename Key, typename Compare = std::less<Key>>
+class BasicAVL : public BasicBinaryTree<Key, Compare> {
+    using Base = BasicBinaryTree<Key, Compare>;
+
 public:
-    // 一次插入过程中，可能发生 0~多次旋转，这里记录每一次
+    using Node = typename Base::Node;
+    using KeyParam = typename Base::KeyParam;
+    using InorderIterator = typename Base::InorderIterator;
+    using InorderRange = typename Base::InorderRange;
+    using Base::rootNode;
+    using Base::clear;
+    using Base::count;
+
+    // 一次插入/删除过程中，可能发生 0~多次旋转，这里按发生顺序（自底向上）记录每一次
     struct RotationRecord {
         enum Type { LL, RR, LR, RL } type;
-        BTNode* z;  // 失衡结点（子树根）
-        BTNode* y;  // z 的孩子（长高一侧）
-        BTNode* x;  // 插入路径上的孙子（可能为 nullptr）
+        Node* z;  // 失衡结点（子树根）
+        Node* y;  // z 的孩子（较高一侧）
+        Node* x;  // y 在旋转方向上的孩子（可能为 nullptr）
     };
 
-    AVL() = default;
+    explicit BasicAVL(const Compare& comp = Compare()) : Base(comp) { this->augmented_ = true; }
     // 对外插入接口：每次插入前先清空旋转记录
-    void insert(int key) {
+    void insert(KeyParam key) {
         rotationRecords_.clear();
         insert_(rootNode, key);
     }
 
-    // 读取本次插入过程中记录下来的旋转信息（只读）
+    // 删除 key：不存在返回 false；每次删除前同样清空旋转记录
+    // 删除后沿回溯路径逐层检查，删除可能让多个祖先先后失衡，所以可能记录多次旋转
+    bool erase(KeyParam key) {
+        rotationRecords_.clear();
+        bool found = false;
+        erase_(rootNode, key, found);
+        return found;
+    }
+
+    // 用另一棵 AVL 形态的树（例如 PersistentAVL 的某个版本）的拷贝替换当前内容，O(n)
+    void assign(const Node* src) {
+        rotationRecords_.clear();
+        clear();
+        rootNode = clone(src);
+    }
+
+    // 读取最近一次插入/删除过程中记录下来的旋转信息（只读）
     const std::vector<RotationRecord>& rotationRecords() const { return rotationRecords_; }
 
+    // 顺序统计：每个结点缓存了子树大小，AVL 树高 O(log n)，下面三个查询都是 O(log n)
+    // select：第 k 小（k 从 1 开始），越界返回 nullptr
+    Node* select(int k) { return selectNode(rootNode, k, [](Node*) {}); }
+    template <typename Visit>
+    Node* select(int k, Visit visit) { return selectNode(rootNode, k, visit); }
+
+    // rank：严格小于 key 的键数
+    int rank(KeyParam key) const { return countBelow(rootNode, key, false, [](Node*) {}); }
+    template <typename Visit>
+    int rank(KeyParam key, Visit visit) const { return countBelow(rootNode, key, false, visit); }
+
+    // countRange：lo <= key <= hi 的键数
+    int countRange(KeyParam lo, KeyParam hi) const {
+        if (comp_(hi, lo)) return 0;
+        return countBelow(rootNode, hi, true, [](Node*) {}) - countBelow(rootNode, lo, false, [](Node*) {});
+    }
+
+    // 按键有序遍历：begin/end、lower_bound/upper_bound 与 range(lo, hi)，区间扫描 O(log n + k)，不申请内存
+    InorderIterator begin() const { return InorderIterator::first(rootNode, comp_); }
+    InorderIterator end() const { return InorderIterator(); }
+    InorderIterator lower_bound(KeyParam key) const { return InorderIterator::seek(rootNode, key, false, comp_); }
+    InorderIterator upper_bound(KeyParam key) const { return InorderIterator::seek(rootNode, key, true, comp_); }
+    InorderRange range(KeyParam lo, KeyParam hi) const {
+        if (comp_(hi, lo)) return InorderRange{};
+        return InorderRange{lower_bound(lo), upper_bound(hi)};
+    }
+
+    // 只读快照：键按 Eytzinger 顺序放进连续数组，无分支查找 + 预取（见 EytzingerSnapshot），O(n)；只对 int 键的树提供
+    bool toEytzinger(EytzingerSnapshot& out) const
+        requires(std::is_same_v<Key, int> && std::is_same_v<Compare, std::less<int>>)
+    {
+        return out.assign(rootNode, count());
+    }
+
+    // 平衡因子 = 左子树高 - 右子树高，直接读结点缓存的高度，O(1)
+    static int balanceFactor(const Node* t) { return t ? heightOf(t->left) - heightOf(t->right) : 0; }
+
+protected:
+    using Base::comp_;
+    using Base::buildNode;
+    using Base::freeNode;
+    using Base::pull;
+    using Base::heightOf;
+    using Base::selectNode;
+    using Base::countBelow;
+
 private:
     std::vector<RotationRecord> rotationRecords_;
 
-    // 计算高度：这里直接递归计算，节点数量不大，足够用
-    static int height(BTNode* t) {
-        if (!t) return 0;
-        int hl = height(t->left);
-        int hr = height(t->right);
-        return (hl > hr ? hl : hr) + 1;
+    // 源树是平衡的，递归深度 O(log n)
+    Node* clone(const Node* s) {
+        if (!s) return nullptr;
+        Node* p = buildNode(s->key);
+        if (!p) return nullptr;
+        p->left = clone(s->left);
+        p->right = clone(s->right);
+        pull(p);
+        return p;
     }
 
-    void recordRotation(RotationRecord::Type t, BTNode* z, BTNode* y, BTNode* x) {
+    void recordRotation(typename RotationRecord::Type t, Node* z, Node* y, Node* x) {
         RotationRecord rec;
         rec.type = t;
         rec.z = z;
@@ -48,78 +125,137 @@ private:
     }
 
     // 单旋 & 双旋（标准 AVL 实现）
-    static void singleRotateLeft(BTNode*& k2) {
-        BTNode* k1 = k2->right;
+    static void singleRotateLeft(Node*& k2) {
+        Node* k1 = k2->right;
         k2->right = k1->left;
         k1->left = k2;
+        pull(k2);   // k2 降为 k1 的孩子，先更新它再更新 k1
+        pull(k1);
         k2 = k1;
     }
 
-    static void singleRotateRight(BTNode*& k2) {
-        BTNode* k1 = k2->left;
+    static void singleRotateRight(Node*& k2) {
+        Node* k1 = k2->left;
         k2->left = k1->right;
         k1->right = k2;
+        pull(k2);
+        pull(k1);
         k2 = k1;
     }
 
-    static void doubleRotateLeft(BTNode*& k3) {
+    static void doubleRotateLeft(Node*& k3) {
         singleRotateRight(k3->right);
         singleRotateLeft(k3);
     }
 
-    static void doubleRotateRight(BTNode*& k3) {
+    static void doubleRotateRight(Node*& k3) {
         singleRotateLeft(k3->left);
         singleRotateRight(k3);
     }
 
     // 递归插入 + 失衡检测 + 旋转记录
-    void insert_(BTNode*& rt, int key) {
+    // 递归深度只有 O(log n)；每层回溯只读孩子缓存的高度并 pull 一次，整次插入 O(log n)
+    void insert_(Node*& rt, KeyParam key) {
         if (!rt) {
-            // BinaryTree 提供的 buildNode 是 protected 静态函数，子类可以直接调用
+            // 结点从 BinaryTree 的结点池里取
             rt = buildNode(key);
             return;
         }
 
-        if (key < rt->key) {
+        if (comp_(key, rt->key)) {
             insert_(rt->left, key);
 
-            if (height(rt->left) - height(rt->right) == 2) {
-                if (key < rt->left->key) {
+            if (balanceFactor(rt) == 2) {
+                if (comp_(key, rt->left->key)) {
                     // LL：对 rt 右旋
-                    BTNode* y = rt->left;
-                    BTNode* x = y ? y->left : nullptr;
+                    Node* y = rt->left;
+                    Node* x = y ? y->left : nullptr;
                     recordRotation(RotationRecord::LL, rt, y, x);
                     singleRotateRight(rt);
                 } else {
                     // LR：先对左子树左旋，再对 rt 右旋
-                    BTNode* y = rt->left;
-                    BTNode* x = y ? y->right : nullptr;
+                    Node* y = rt->left;
+                    Node* x = y ? y->right : nullptr;
                     recordRotation(RotationRecord::LR, rt, y, x);
                     doubleRotateRight(rt);
                 }
             }
-        } else if (key > rt->key) {
+        } else if (comp_(rt->key, key)) {
             insert_(rt->right, key);
 
-            if (height(rt->right) - height(rt->left) == 2) {
-                if (key > rt->right->key) {
+            if (balanceFactor(rt) == -2) {
+                if (comp_(rt->right->key, key)) {
                     // RR：对 rt 左旋
-                    BTNode* y = rt->right;
-                    BTNode* x = y ? y->right : nullptr;
+                    Node* y = rt->right;
+                    Node* x = y ? y->right : nullptr;
                     recordRotation(RotationRecord::RR, rt, y, x);
                     singleRotateLeft(rt);
                 } else {
                     // RL：先对右子树右旋，再对 rt 左旋
-                    BTNode* y = rt->right;
-                    BTNode* x = y ? y->left : nullptr;
+                    Node* y = rt->right;
+                    Node* x = y ? y->left : nullptr;
                     recordRotation(RotationRecord::RL, rt, y, x);
                     doubleRotateLeft(rt);
                 }
             }
         }
+        pull(rt);
+    }
+
+    // 删除后的再平衡：按较高一侧孩子的平衡因子选 LL/LR/RR/RL
+    // 与插入不同，孩子的平衡因子可能为 0，此时单旋即可
+    void rebalance(Node*& rt) {
+        const int bf = balanceFactor(rt);
+        if (bf == 2) {
+            Node* y = rt->left;
+            if (balanceFactor(y) >= 0) {
+                recordRotation(RotationRecord::LL, rt, y, y->left);
+                singleRotateRight(rt);
+            } else {
+                recordRotation(RotationRecord::LR, rt, y, y->right);
+                doubleRotateRight(rt);
+            }
+        } else if (bf == -2) {
+            Node* y = rt->right;
+            if (balanceFactor(y) <= 0) {
+                recordRotation(RotationRecord::RR, rt, y, y->right);
+                singleRotateLeft(rt);
+            } else {
+                recordRotation(RotationRecord::RL, rt, y, y->left);
+                doubleRotateLeft(rt);
+            }
+        }
+    }
+
+    // 递归删除：两个孩子时用右子树最小结点（中序后继）的键覆盖当前结点，再到右子树删除后继
+    void erase_(Node*& rt, KeyParam key, bool& found) {
+        if (!rt) return;
+
+        if (comp_(key, rt->key)) {
+            erase_(rt->left, key, found);
+        } else if (comp_(rt->key, key)) {
+            erase_(rt->right, key, found);
+        } else {
+            found = true;
+            if (rt->left && rt->right) {
+                const Node* succ = rt->right;
+                while (succ->left) succ = succ->left;
+                rt->key = succ->key;
+                erase_(rt->right, rt->key, found);  // 按 rt 上的副本找：后继结点在这次删除里会被释放
+            } else {
+                Node* old = rt;
+                rt = rt->left ? rt->left : rt->right;
+                freeNode(old);
+                return;  // 顶替上来的孩子本身平衡，高度也不变
+            }
+        }
+        pull(rt);
+        rebalance(rt);
     }
 };
 
+using AVL = BasicAVL<int>;
+
 } // namespace ds
 
 #endif // AVL_H
@@ -0,0 +1,167 @@
+//
+// Created by xiang on 26-10-17.
+//
+// AVL 建树基准：每层回溯都递归求高度的旧实现（单次插入 O(n)） 对比 读结点缓存高度的 ds::AVL（单次插入 O(log n)）
+// 输出总耗时和 ns/(n·log2 n)：新实现这一列应大致保持不变，说明建树是 O(n log n)
+// 另测 avlBuild 动画的准备开销：逐步“清空 + 重放前缀”对比 持久化版本（每步只复制一条路径）
+// 以及顺序统计：inorder 到缓冲区再取第 k 个 / 数个数（O(n)） 对比 select / rank / countRange（O(log n)）
+//
+
+#include "bench_util.h"
+#include "avl.h"
+#include "persistentavl.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace legacy {
+    // 缓存高度之前的 ds::AVL::insert（去掉了旋转记录，只保留结构调整）
+    class AVL : public ds::BinaryTree {
+        static int height(ds::BTNode* t) {
+            if (!t) return 0;
+            const int hl = height(t->left), hr = height(t->right);
+            return (hl > hr ? hl : hr) + 1;
+        }
+        static void rotateLeft(ds::BTNode*& k2) { ds::BTNode* k1 = k2->right; k2->right = k1->left; k1->left = k2; k2 = k1; }
+        static void rotateRight(ds::BTNode*& k2) { ds::BTNode* k1 = k2->left; k2->left = k1->right; k1->right = k2; k2 = k1; }
+        void insert_(ds::BTNode*& rt, int key) {
+            if (!rt) { rt = buildNode(key); return; }
+            if (key < rt->key) {
+                insert_(rt->left, key);
+                if (height(rt->left) - height(rt->right) == 2) {
+                    if (key < rt->left->key) rotateRight(rt);
+                    else { rotateLeft(rt->left); rotateRight(rt); }
+                }
+            } else if (key > rt->key) {
+                insert_(rt->right, key);
+                if (height(rt->right) - height(rt->left) == 2) {
+                    if (key > rt->right->key) rotateLeft(rt);
+                    else { rotateRight(rt->right); rotateLeft(rt); }
+                }
+            }
+        }
+    public:
+        void insert(int key) { insert_(rootNode, key); }
+    };
+} // namespace legacy
+
+template <typename T>
+static double build(int n, bool sorted) {
+    T t;
+    bench::Rng rng(11);
+    bench::Timer timer;
+    for (int i = 0; i < n; ++i) t.insert(sorted ? i : static_cast<int>(rng.next() & 0x7fffffff));
+    const double ms = timer.ms();
+    bench::consume(t.root() ? t.root()->key : 0);
+    return ms;
+}
+
+// 旧动画：第 i 步先拷贝前 i 个键，再清空重放（步骤里做的事）
+static double replaySteps(const std::vector<int>& keys) {
+    bench::Timer timer;
+    std::vector<int> built;
+    ds::AVL avl;
+    for (int v : keys) {
+        std::vector<int> restore = built;
+        avl.clear();
+        for (int k : restore) avl.insert(k);
+        avl.insert(v);
+        built.push_back(v);
+    }
+    bench::consume(avl.count());
+    return timer.ms();
+}
+
+// 新动画：每步拿到插入前后两个版本，最后把终版拷进可修改的树
+static double persistentSteps(const std::vector<int>& keys, int* nodes) {
+    bench::Timer timer;
+    ds::PersistentAVL history;
+    ds::PersistentAVL::Version cur = nullptr;
+    std::vector<ds::PersistentAVL::Version> versions;
+    versions.reserve(keys.size());
+    for (int v : keys) {
+        cur = history.insert(cur, v);
+        versions.push_back(cur);
+    }
+    ds::AVL avl;
+    avl.assign(cur);
+    bench::consume(avl.count());
+    *nodes = history.nodeCount();
+    return timer.ms();
+}
+
+static double perNLogN(double ms, int n) {
+    return ms * 1e6 / (static_cast<double>(n) * std::log2(static_cast<double>(n)));
+}
+
+int main(int argc, char** argv) {
+    const long long maxN = bench::argOr(argc, argv, 1000000);
+    const int sizes[] = {10000, 30000, 100000, 300000, 1000000};
+
+    for (bool sorted : {true, false}) {
+        std::printf("== %s keys ==\n", sorted ? "sorted" : "random");
+        for (int n : sizes) {
+            if (n > maxN) break;
+            // 旧实现是平方级，规模大时只跑新实现
+            const double base = (n <= 30000) ? build<legacy::AVL>(n, sorted) : 0.0;
+            const double ms = build<ds::AVL>(n, sorted);
+            bench::row("avl build", n, base, ms, "recursive", "cached");
+            std::printf("%28s ns/(n log2 n) = %.2f\n", "", perNLogN(ms, n));
+        }
+    }
+
+    std::printf("== avlBuild animation prepare ==\n");
+    for (int n : {1000, 3000, 10000, 100000}) {
+        if (n > maxN) break;
+        std::vector<int> keys(static_cast<std::size_t>(n));
+        bench::Rng rng(5);
+        for (int& k : keys) k = static_cast<int>(rng.next() & 0x7fffffff);
+        // 重放是平方级，只在小规模上跑
+        const double base = (n <= 3000) ? replaySteps(keys) : 0.0;
+        int nodes = 0;
+        bench::row("avl steps", n, base, persistentSteps(keys, &nodes), "replay", "versions");
+        std::printf("%28s version nodes = %d (%.1f per insert)\n", "", nodes, static_cast<double>(nodes) / n);
+    }
+
+    std::printf("== order statistics (1000 queries) ==\n");
+    for (int n : {10000, 100000, 1000000}) {
+        if (n > maxN) break;
+        ds::AVL t;
+        bench::Rng rng(11);
+        for (int i = 0; i < n; ++i) t.insert(rng.below(1 << 30));
+        const int m = t.count();
+        std::vector<int> buf(static_cast<std::size_t>(m));
+        const int q = 1000;
+
+        // 每次查询都 inorder 一遍是 O(n)，10^6 时要跑几分钟，只在较小规模上跑
+        const bool legacyOk = n <= 100000;
+        bench::Timer timer;
+        long long a = 0;
+        for (int i = 0; i < q && legacyOk; ++i) {
+            t.inorder(buf.data(), m);
+            a += buf[static_cast<std::size_t>(rng.below(m))];
+        }
+        const double selOld = legacyOk ? timer.ms() : 0.0;
+        timer.reset();
+        long long b = 0;
+        for (int i = 0; i < q; ++i) b += t.select(1 + rng.below(m))->key;
+        bench::row("k-th smallest", n, selOld, timer.ms(), "inorder", "select");
+
+        timer.reset();
+        for (int i = 0; i < q && legacyOk; ++i) {
+            const int lo = rng.below(1 << 30), hi = lo + rng.below(1 << 26);
+            t.inorder(buf.data(), m);
+            for (int k : buf) a += (k >= lo && k <= hi);
+        }
+        const double cntOld = legacyOk ? timer.ms() : 0.0;
+        timer.reset();
+        for (int i = 0; i < q; ++i) {
+            const int lo = rng.below(1 << 30), hi = lo + rng.below(1 << 26);
+            b += t.countRange(lo, hi);
+        }
+        bench::row("count in range", n, cntOld, timer.ms(), "inorder", "countRange");
+        bench::consume(a + b);
+    }
+    return 0;
+}
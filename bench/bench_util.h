@@ -0,0 +1,67 @@
+//
+// Created by xiang on 26-10-17.
+//
+// 基准程序共用的小工具：计时、防优化、参数读取。只依赖标准库。
+//
+
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+
+namespace bench {
+
+    // 单调时钟计时器，构造即开始
+    class Timer {
+        std::chrono::steady_clock::time_point t0;
+    public:
+        Timer() : t0(std::chrono::steady_clock::now()) {}
+        void reset() { t0 = std::chrono::steady_clock::now(); }
+        double ms() const {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        }
+    };
+
+    // 把结果“用掉”，避免编译器把被测代码整段删掉
+    inline volatile std::uint64_t g_sink = 0;
+    template <typename T>
+    inline void consume(const T& v) { g_sink = g_sink + static_cast<std::uint64_t>(v); }
+
+    // xorshift64：可复现、足够快的伪随机数
+    class Rng {
+        std::uint64_t s;
+    public:
+        explicit Rng(std::uint64_t seed = 0x9E3779B97F4A7C15ull) : s(seed ? seed : 1) {}
+        std::uint64_t next() {
+            s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+            return s;
+        }
+        int below(int n) { return n > 0 ? static_cast<int>(next() % static_cast<std::uint64_t>(n)) : 0; }
+    };
+
+    // argv[1] 可覆盖规模上限（例如在慢机器上跑小一点）
+    inline long long argOr(int argc, char** argv, long long def) {
+        if (argc > 1) {
+            long long v = std::atoll(argv[1]);
+            if (v > 0) return v;
+        }
+        return def;
+    }
+
+    // baseMs <= 0 表示对照组没有跑（例如旧实现在该规模下太慢）
+    inline void row(const char* name, long long n, double baseMs, double newMs,
+                    const char* baseLabel = "legacy", const char* newLabel = "new") {
+        if (baseMs <= 0) {
+            std::printf("%-28s n=%-10lld %8s    skipped   %8s %10.2f ms\n", name, n, baseLabel, newLabel, newMs);
+            return;
+        }
+        std::printf("%-28s n=%-10lld %8s %10.2f ms   %8s %10.2f ms   x%.2f\n",
+                    name, n, baseLabel, baseMs, newLabel, newMs, newMs > 0 ? baseMs / newMs : 0.0);
+    }
+
+} // namespace bench
+
+#endif // BENCH_UTIL_H
@@ -0,0 +1,207 @@
+//
+// Created by xiang on 26-10-17.
+//
+// 二叉树基准：递归实现 对比 非递归实现（显式栈遍历）
+// 三种形状各 n 个结点：完全二叉树、右斜链（有序插入 BST 的样子）、左斜链。
+// 斜链深度为 n，递归版会爆栈，只在完全二叉树上跑对照组。
+// 最后一节比较结点内存：每个结点单独 malloc/free 对比 结点池（按块分配，清空时整池复位）。
+//
+
+#include "bench_util.h"
+#include "binarytree.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace legacy {
+    // 改造前 BinaryTree 的递归实现
+    static int height(const ds::BTNode* p) {
+        if (!p) return 0;
+        const int lh = height(p->left), rh = height(p->right);
+        return (lh > rh ? lh : rh) + 1;
+    }
+    static int count(const ds::BTNode* p) { return p ? 1 + count(p->left) + count(p->right) : 0; }
+    static void preorder(const ds::BTNode* p, int* out, int& cnt) {
+        if (!p) return;
+        out[cnt++] = p->key;
+        preorder(p->left, out, cnt);
+        preorder(p->right, out, cnt);
+    }
+    static void inorder(const ds::BTNode* p, int* out, int& cnt) {
+        if (!p) return;
+        inorder(p->left, out, cnt);
+        out[cnt++] = p->key;
+        inorder(p->right, out, cnt);
+    }
+    static void postorder(const ds::BTNode* p, int* out, int& cnt) {
+        if (!p) return;
+        postorder(p->left, out, cnt);
+        postorder(p->right, out, cnt);
+        out[cnt++] = p->key;
+    }
+    static void destroy(ds::BTNode* p) {
+        if (!p) return;
+        destroy(p->left);
+        destroy(p->right);
+        std::free(p);
+    }
+
+    // 改造前的结点管理：每个结点单独 malloc，层序数组建树（同 BinaryTree::buildTree）
+    static ds::BTNode* buildTree(const int* arr, int n, int null) {
+        if (n <= 0 || arr[0] == null) return nullptr;
+        std::vector<ds::BTNode*> q(static_cast<std::size_t>(n));
+        auto make = [](int key) {
+            auto* p = static_cast<ds::BTNode*>(std::malloc(sizeof(ds::BTNode)));
+            p->key = key;
+            p->left = p->right = nullptr;
+            p->size = p->height = 1;
+            return p;
+        };
+        int head = 0, tail = 0, idx = 1;
+        ds::BTNode* root = make(arr[0]);
+        q[tail++] = root;
+        while (head < tail && idx < n) {
+            ds::BTNode* p = q[head++];
+            if (idx < n && arr[idx] != null) q[tail++] = p->left = make(arr[idx]);
+            ++idx;
+            if (idx < n && arr[idx] != null) q[tail++] = p->right = make(arr[idx]);
+            ++idx;
+        }
+        return root;
+    }
+
+    // 改造前的清空：把左孩子旋上来，沿右链逐个 free（斜链也不爆栈）
+    static void freeAll(ds::BTNode* p) {
+        while (p) {
+            if (p->left) {
+                ds::BTNode* l = p->left;
+                p->left = l->right;
+                l->right = p;
+                p = l;
+            } else {
+                ds::BTNode* r = p->right;
+                std::free(p);
+                p = r;
+            }
+        }
+    }
+} // namespace legacy
+
+enum class Shape { Complete, RightChain, LeftChain };
+
+// buildTree 的层序数组（斜链用哨兵 -1 占掉另一侧）
+//   右斜链：0, -1, 1, -1, 2, ...    左斜链：0, 1, -1, 2, -1, ...
+static std::vector<int> levelArray(Shape shape, int n) {
+    std::vector<int> a;
+    a.reserve(static_cast<std::size_t>(n) * 2);
+    for (int i = 0; i < n; ++i) {
+        if (shape == Shape::Complete) { a.push_back(i); continue; }
+        if (shape == Shape::LeftChain) { a.push_back(i); if (i > 0) a.push_back(-1); continue; }
+        a.push_back(i); a.push_back(-1);
+    }
+    return a;
+}
+
+static void build(ds::BinaryTree& t, Shape shape, int n) {
+    const std::vector<int> a = levelArray(shape, n);
+    t.buildTree(a.data(), static_cast<int>(a.size()), -1);
+}
+
+// 反复“建整棵树 -> 清空”：malloc 版每轮都要逐个申请、逐个释放；结点池第一轮之后块全部复用，清空 O(1)
+static void arena(int n, int rounds) {
+    const std::vector<int> a = levelArray(Shape::Complete, n);
+    const int m = static_cast<int>(a.size());
+    std::printf("== node memory: complete tree, n=%d, %d rounds of build + clear ==\n", n, rounds);
+
+    bench::Timer timer;
+    double buildOld = 0, clearOld = 0;
+    for (int r = 0; r < rounds; ++r) {
+        timer.reset();
+        ds::BTNode* root = legacy::buildTree(a.data(), m, -1);
+        buildOld += timer.ms();
+        bench::consume(root->key);
+        timer.reset();
+        legacy::freeAll(root);
+        clearOld += timer.ms();
+    }
+
+    ds::BinaryTree t;
+    ds::BinaryTree::ArenaStats st{};
+    double buildNew = 0, clearNew = 0;
+    for (int r = 0; r < rounds; ++r) {
+        timer.reset();
+        t.buildTree(a.data(), m, -1);
+        buildNew += timer.ms();
+        bench::consume(t.root()->key);
+        st = t.arenaStats();  // 清空前的占用
+        timer.reset();
+        t.clear();
+        clearNew += timer.ms();
+    }
+    bench::row("build", n, buildOld, buildNew, "malloc", "arena");
+    bench::row("clear", n, clearOld, clearNew, "free", "arena");
+
+    std::printf("   (arena: %d nodes, %.2f MB in use, %.2f MB reserved in %d chunks)\n", st.liveNodes,
+                st.bytesInUse / 1048576.0, st.bytesReserved / 1048576.0, st.chunks);
+}
+
+int main(int argc, char** argv) {
+    const int n = static_cast<int>(bench::argOr(argc, argv, 1000000));
+    std::vector<int> out(static_cast<std::size_t>(n));
+
+    const struct { Shape shape; const char* name; } shapes[] = {
+        {Shape::Complete,   "complete"},
+        {Shape::RightChain, "right chain"},
+        {Shape::LeftChain,  "left chain"},
+    };
+
+    for (const auto& sh : shapes) {
+        std::printf("== %s, n=%d ==\n", sh.name, n);
+        const bool legacyOk = (sh.shape == Shape::Complete);
+        ds::BinaryTree t;
+        build(t, sh.shape, n);
+
+        bench::Timer timer;
+        auto lap = [&timer]() { const double ms = timer.ms(); timer.reset(); return ms; };
+        int cnt = 0;
+
+        double base = 0;
+        if (legacyOk) { timer.reset(); bench::consume(legacy::height(t.root())); base = lap(); }
+        timer.reset(); const int h = t.height(); bench::consume(h);
+        bench::row("height", n, base, lap(), "recursive", "iterative");
+
+        base = 0;
+        if (legacyOk) { timer.reset(); bench::consume(legacy::count(t.root())); base = lap(); }
+        timer.reset(); bench::consume(t.count());
+        bench::row("count", n, base, lap(), "recursive", "iterative");
+
+        base = 0;
+        if (legacyOk) { timer.reset(); cnt = 0; legacy::preorder(t.root(), out.data(), cnt); base = lap(); }
+        timer.reset(); bench::consume(t.preorder(out.data(), n));
+        bench::row("preorder", n, base, lap(), "recursive", "iterative");
+
+        base = 0;
+        if (legacyOk) { timer.reset(); cnt = 0; legacy::inorder(t.root(), out.data(), cnt); base = lap(); }
+        timer.reset(); bench::consume(t.inorder(out.data(), n));
+        bench::row("inorder", n, base, lap(), "recursive", "iterative");
+
+        base = 0;
+        if (legacyOk) { timer.reset(); cnt = 0; legacy::postorder(t.root(), out.data(), cnt); base = lap(); }
+        timer.reset(); bench::consume(t.postorder(out.data(), n));
+        bench::row("postorder", n, base, lap(), "recursive", "iterative");
+
+        base = 0;
+        if (legacyOk) {
+            const std::vector<int> a = levelArray(sh.shape, n);
+            ds::BTNode* u = legacy::buildTree(a.data(), static_cast<int>(a.size()), -1);
+            timer.reset();
+            legacy::destroy(u);
+            base = lap();
+        }
+        timer.reset(); t.clear();
+        bench::row("destroy", n, base, lap(), "recursive", "arena");
+        std::printf("   (height %d)\n", h);
+    }
+    arena(n, 5);
+    return 0;
+}
@@ -0,0 +1,209 @@
+//
+// Created by xiang on 26-10-17.
+//
+// BST 删除基准：旧做法（右子树接到左子树最大结点下） 对比 中序后继顶替
+// 随机建 n 个结点的树，再做 rounds 轮“删一个已有键 + 插一个新键”，树的结点数不变；
+// 输出前后的平均深度、树高，以及翻动之后 n 次查找的耗时。
+// 另测插入吞吐：递归插入（回溯时逐层改写孩子指针） 对比 指向指针的非递归插入，随机键与有序键各一组；
+// 以及整批建树：逐个 insert 对比 bulkLoad（保持插入形状 / 完全平衡），和原地 DSW 平衡化；
+// 最后是区间扫描：先数结点再 inorder 到缓冲区、过滤出区间 对比 range(lo, hi) 迭代器（O(log n + k)，树高不超过 64 时不申请内存）；
+// 再用降序键建一条左斜链，整趟扫描 inorder 对比 range()，确认迭代器在退化树上仍是 O(n)，不随规模平方增长。
+//
+
+#include "bench_util.h"
+#include "binarysearchtree.h"
+
+#include <cstdio>
+#include <vector>
+
+using Mode = ds::BinarySearchTree::EraseMode;
+
+namespace legacy {
+    // 改造前的递归插入：每层回溯都把孩子指针重新赋值一遍
+    class BST : public ds::BinaryTree {
+        ds::BTNode* insertNode(ds::BTNode* root, int key) {
+            if (!root) return buildNode(key);
+            if (key < root->key) root->left = insertNode(root->left, key);
+            else if (key > root->key) root->right = insertNode(root->right, key);
+            pull(root);
+            return root;
+        }
+    public:
+        BST() { augmented_ = true; }
+        void insert(int key) { rootNode = insertNode(rootNode, key); }
+    };
+} // namespace legacy
+
+template <typename T>
+static double insertAll(const std::vector<int>& keys) {
+    T t;
+    bench::Timer timer;
+    for (int k : keys) t.insert(k);
+    const double ms = timer.ms();
+    bench::consume(t.count());
+    return ms;
+}
+
+// 平均深度（根为 0）：每个结点在它所有祖先（含自身）的 size 里各被数一次，所以 Σsize = Σ(depth + 1)
+static double avgDepth(const ds::BinarySearchTree& t) {
+    long long sum = 0;
+    ds::BinaryTree::preorderWalk(t.root(), [&sum](ds::BTNode* p) { sum += p->size; });
+    const int n = t.count();
+    return n > 0 ? static_cast<double>(sum) / n - 1.0 : 0.0;
+}
+
+struct Churn { double depthBefore, depthAfter; int heightBefore, heightAfter; double churnMs, findMs; };
+
+static Churn run(Mode mode, int n, int rounds) {
+    ds::BinarySearchTree t;
+    t.setEraseMode(mode);
+    bench::Rng rng(7);
+    const int range = 1 << 30;
+
+    // live 保存树中现有的键，便于随机挑一个删掉
+    std::vector<int> live;
+    live.reserve(static_cast<std::size_t>(n));
+    while (static_cast<int>(live.size()) < n) {
+        const int k = static_cast<int>(rng.below(range));
+        if (t.find(k)) continue;
+        t.insert(k);
+        live.push_back(k);
+    }
+
+    Churn c{};
+    c.depthBefore = avgDepth(t);
+    c.heightBefore = t.height();
+
+    bench::Timer timer;
+    for (int r = 0; r < rounds; ++r) {
+        const std::size_t i = static_cast<std::size_t>(rng.below(static_cast<int>(live.size())));
+        t.eraseKey(live[i]);
+        int k;
+        do { k = static_cast<int>(rng.below(range)); } while (t.find(k));
+        t.insert(k);
+        live[i] = k;
+    }
+    c.churnMs = timer.ms();
+    c.depthAfter = avgDepth(t);
+    c.heightAfter = t.height();
+
+    timer.reset();
+    long long hit = 0;
+    for (int k : live) hit += t.find(k) != nullptr;
+    c.findMs = timer.ms();
+    bench::consume(hit);
+    return c;
+}
+
+int main(int argc, char** argv) {
+    const int n = static_cast<int>(bench::argOr(argc, argv, 10000));
+    for (int rounds : {n, 4 * n, 16 * n}) {
+        const Churn a = run(Mode::LegacyJoinMax, n, rounds);
+        const Churn b = run(Mode::Successor, n, rounds);
+        std::printf("== n=%d, %d erase+insert rounds ==\n", n, rounds);
+        std::printf("%-10s avg depth %6.1f -> %8.1f   height %4d -> %6d\n",
+                    "legacy", a.depthBefore, a.depthAfter, a.heightBefore, a.heightAfter);
+        std::printf("%-10s avg depth %6.1f -> %8.1f   height %4d -> %6d\n",
+                    "successor", b.depthBefore, b.depthAfter, b.heightBefore, b.heightAfter);
+        bench::row("churn", rounds, a.churnMs, b.churnMs, "legacy", "successor");
+        bench::row("find after churn", n, a.findMs, b.findMs, "legacy", "successor");
+    }
+
+    std::printf("== insert throughput ==\n");
+    {
+        // 随机键：树高 O(log n)，两者差别只在回溯时的写
+        const int m = 1000000;
+        std::vector<int> keys(static_cast<std::size_t>(m));
+        bench::Rng rng(3);
+        for (int& k : keys) k = rng.below(1 << 30);
+        bench::row("insert random", m, insertAll<legacy::BST>(keys), insertAll<ds::BinarySearchTree>(keys),
+                   "recursive", "iterative");
+    }
+    {
+        // 有序键：树退化成右斜链，每次插入都走到底；规模再大递归版就会爆栈
+        const int m = 10000;
+        std::vector<int> keys(static_cast<std::size_t>(m));
+        for (int i = 0; i < m; ++i) keys[static_cast<std::size_t>(i)] = i;
+        bench::row("insert sorted", m, insertAll<legacy::BST>(keys), insertAll<ds::BinarySearchTree>(keys),
+                   "recursive", "iterative");
+    }
+
+    std::printf("== bulk load ==\n");
+    for (bool sorted : {false, true}) {
+        const int m = sorted ? 20000 : 1000000;
+        std::vector<int> keys(static_cast<std::size_t>(m));
+        bench::Rng rng(9);
+        for (int i = 0; i < m; ++i) keys[static_cast<std::size_t>(i)] = sorted ? i : rng.below(1 << 30);
+        const char* tag = sorted ? "sorted" : "random";
+
+        const double base = insertAll<ds::BinarySearchTree>(keys);
+        ds::BinarySearchTree t;
+        bench::Timer timer;
+        t.bulkLoad(keys.data(), m, ds::BinarySearchTree::LoadMode::InsertionOrder);
+        std::printf("%s keys:\n", tag);
+        bench::row("  same shape", m, base, timer.ms(), "insert", "bulkLoad");
+        const int h = t.height();
+
+        ds::BinarySearchTree b;
+        timer.reset();
+        b.bulkLoad(keys.data(), m, ds::BinarySearchTree::LoadMode::Balanced);
+        bench::row("  balanced", m, base, timer.ms(), "insert", "bulkLoad");
+
+        timer.reset();
+        t.balance();
+        const double dsw = timer.ms();
+        std::printf("%28s DSW balance() %.2f ms, height %d -> %d\n", "", dsw, h, t.height());
+    }
+
+    std::printf("== range scan (~100 keys per query; 1000 queries, 100 at n=10^6) ==\n");
+    for (int m : {10000, 100000, 1000000}) {
+        std::vector<int> keys(static_cast<std::size_t>(m));
+        bench::Rng rng(17);
+        for (int& k : keys) k = rng.below(1 << 30);
+        ds::BinarySearchTree t;
+        t.bulkLoad(keys.data(), m, ds::BinarySearchTree::LoadMode::InsertionOrder);
+        const int span = static_cast<int>((1LL << 30) / t.count() * 100);
+        const int q = m <= 100000 ? 1000 : 100;  // 旧做法每次 O(n)，大规模时少跑几次
+
+        bench::Timer timer;
+        long long a = 0;
+        for (int i = 0; i < q; ++i) {
+            const int lo = rng.below(1 << 30), hi = lo + span;
+            const int need = t.inorder(nullptr, 0);
+            std::vector<int> buf(static_cast<std::size_t>(need));
+            t.inorder(buf.data(), need);
+            for (int k : buf) if (k >= lo && k <= hi) a += k;
+        }
+        const double old = timer.ms();
+        timer.reset();
+        long long b = 0;
+        for (int i = 0; i < q; ++i) {
+            const int lo = rng.below(1 << 30), hi = lo + span;
+            for (int k : t.range(lo, hi)) b += k;
+        }
+        bench::row("range scan", m, old, timer.ms(), "inorder", "range()");
+        bench::consume(a + b);
+    }
+
+    std::printf("== full scan of a degenerate tree (descending keys, left chain) ==\n");
+    for (int m : {10000, 40000, 160000}) {
+        std::vector<int> keys(static_cast<std::size_t>(m));
+        for (int i = 0; i < m; ++i) keys[static_cast<std::size_t>(i)] = m - i;
+        ds::BinarySearchTree t;
+        t.bulkLoad(keys.data(), m, ds::BinarySearchTree::LoadMode::InsertionOrder);
+
+        bench::Timer timer;
+        std::vector<int> buf(static_cast<std::size_t>(m));
+        t.inorder(buf.data(), m);
+        long long a = 0;
+        for (int k : buf) a += k;
+        const double old = timer.ms();
+        timer.reset();
+        long long b = 0;
+        for (int k : t.range(1, m)) b += k;
+        bench::row("degenerate scan", m, old, timer.ms(), "inorder", "range()");
+        if (a != b) std::printf("   MISMATCH: %lld / %lld\n", a, b);
+        bench::consume(a + b);
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+//
+// Created by xiang on 26-10-17.
+//
+// 并发栈基准：std::mutex 保护的 ds::Stack 对比 无锁 ds::ConcurrentStack
+// 1..N 个线程同时对同一个栈做 push/pop 混合操作（每轮 push 两次 pop 两次），统计总吞吐（百万次操作/秒）
+//
+
+#include "bench_util.h"
+#include "stack.h"
+#include "concurrentstack.h"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 对照组：一把互斥锁包住单线程栈
+class LockedStack {
+    ds::Stack st;
+    std::mutex m;
+public:
+    bool push(int value) { std::lock_guard<std::mutex> g(m); return st.push(value); }
+    bool pop(int* out) { std::lock_guard<std::mutex> g(m); return st.pop(out); }
+};
+
+// 返回整个过程的耗时（毫秒）；所有线程就位后同时开跑
+template <typename S>
+static double run(int threads, int roundsPerThread) {
+    S s;
+    for (int i = 0; i < 1024; ++i) s.push(i);  // 预热：避免一开始就空栈
+
+    std::atomic<int> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> pool;
+    pool.reserve(static_cast<std::size_t>(threads));
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&s, &ready, &go, roundsPerThread, t]() {
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) {}
+            long long sum = 0;
+            int out = 0;
+            for (int k = 0; k < roundsPerThread; ++k) {
+                s.push(t + k);
+                s.push(k);
+                if (s.pop(&out)) sum += out;
+                if (s.pop(&out)) sum += out;
+            }
+            bench::consume(sum);
+        });
+    }
+    while (ready.load() < threads) {}
+    bench::Timer timer;
+    go.store(true, std::memory_order_release);
+    for (auto& th : pool) th.join();
+    return timer.ms();
+}
+
+int main(int argc, char** argv) {
+    const int rounds = static_cast<int>(bench::argOr(argc, argv, 1000000));
+    unsigned hw = std::thread::hardware_concurrency();
+    if (hw == 0) hw = 4;
+
+    std::printf("%-8s %14s %14s %8s\n", "threads", "mutex Mops/s", "lockfree Mops/s", "ratio");
+    for (unsigned t = 1; t <= hw; t = (t < hw && t * 2 > hw) ? hw : t * 2) {
+        const int ti = static_cast<int>(t);
+        const double ops = 4.0 * rounds * ti;
+        const double a = run<LockedStack>(ti, rounds);
+        const double b = run<ds::ConcurrentStack>(ti, rounds);
+        const double ma = ops / (a * 1000.0), mb = ops / (b * 1000.0);
+        std::printf("%-8d %14.2f %14.2f %8.2f\n", ti, ma, mb, ma > 0 ? mb / ma : 0.0);
+        if (t == hw) break;
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+//
+// Created by xiang on 26-10-17.
+//
+// 读多写少时的查找：BinarySearchTree::find（沿指针下降） 对比 toEytzinger() 快照（连续数组、无分支比较 + 预取）
+// 规模 10^3 ~ 10^7 个键，树用 bulkLoad(Balanced) 建成完全平衡的形状（对指针版最有利）。
+// 两种查询流，各 2·10^6 次，一半命中一半不命中：
+// - random：在整个键空间里均匀取；
+// - skewed：u^4 的幂律分布，查询集中在最小的一小段键上（热点常驻缓存）。
+// 快照分别测逐个 find 与 findBatch（按组交错推进）。
+//
+
+#include "bench_util.h"
+#include "binarysearchtree.h"
+#include "eytzinger.h"
+
+#include <cstdio>
+#include <vector>
+
+// 键为 0, 2, 4, ...：偶数命中，奇数不命中
+static std::vector<int> makeQueries(int n, int m, bool skewed, bench::Rng& rng) {
+    std::vector<int> q(static_cast<std::size_t>(m));
+    for (int& x : q) {
+        long long r;
+        if (skewed) {
+            const double u = static_cast<double>(rng.next() >> 11) / 9007199254740992.0;  // [0, 1)
+            r = static_cast<long long>(u * u * u * u * n);
+        } else {
+            r = rng.below(n);
+        }
+        x = static_cast<int>(2 * r + (rng.next() & 1));
+    }
+    return q;
+}
+
+int main(int argc, char** argv) {
+    const long long maxN = bench::argOr(argc, argv, 10000000);
+    const int m = 2000000;
+    bench::Rng rng(17);
+
+    for (int n : {1000, 10000, 100000, 1000000, 10000000}) {
+        if (n > maxN) break;
+        std::vector<int> keys(static_cast<std::size_t>(n));
+        for (int i = 0; i < n; ++i) keys[static_cast<std::size_t>(i)] = 2 * i;
+        ds::BinarySearchTree t;
+        t.bulkLoad(keys.data(), n, ds::BinarySearchTree::LoadMode::Balanced);
+
+        bench::Timer timer;
+        ds::EytzingerSnapshot snap;
+        t.toEytzinger(snap);
+        const double snapMs = timer.ms();
+        std::printf("== n=%d (tree height %d, snapshot %.2f ms) ==\n", n, t.height(), snapMs);
+
+        for (bool skewed : {false, true}) {
+            const std::vector<int> q = makeQueries(n, m, skewed, rng);
+            const char* name = skewed ? "skewed queries" : "random queries";
+
+            int hitTree = 0, hitSnap = 0;
+            timer.reset();
+            for (int x : q) hitTree += t.find(x) != nullptr;
+            const double treeMs = timer.ms();
+
+            timer.reset();
+            for (int x : q) hitSnap += snap.find(x) != nullptr;
+            const double snapFind = timer.ms();
+
+            timer.reset();
+            const int hitBatch = snap.findBatch(q.data(), m, nullptr);
+            const double snapBatch = timer.ms();
+
+            bench::row(name, n, treeMs, snapFind, "bst", "eytz");
+            bench::row(name, n, treeMs, snapBatch, "bst", "batch");
+            if (hitTree != hitSnap || hitTree != hitBatch) std::printf("   MISMATCH: hits %d / %d / %d\n", hitTree, hitSnap, hitBatch);
+            bench::consume(hitTree + hitSnap + hitBatch);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,178 @@
+//
+// Created by xiang on 26-10-17.
+//
+// 哈夫曼字节编解码吞吐（MB/s，按原始数据字节数计）：
+// - 编码：逐位写出（每位一次移位判断） 对比 64 位位缓冲整块写出；
+// - 解码：沿哈夫曼树一次走一位 对比 多位查表。
+// 三组数据：均匀随机字节（码长几乎都是 8）、类文本（少数字节占大头）、几何分布（码长很长，表外长码多）。
+// 另对后两组比较限长码（package-merge）：最大码长 15 / 12 / 11 时的压缩损失和查表解码速度。
+//
+
+#include "bench_util.h"
+#include "huffmancodec.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using Codec = ds::HuffmanCodec;
+
+namespace legacy {
+    // 逐位写出
+    static std::size_t encode(const Codec& c, const std::uint8_t* in, std::size_t n, std::uint8_t* out) {
+        std::size_t pos = 0;
+        int bit = 0;
+        std::uint8_t cur = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const int l = c.length(in[i]);
+            const std::uint64_t code = c.code(in[i]);
+            for (int k = l - 1; k >= 0; --k) {
+                cur = static_cast<std::uint8_t>((cur << 1) | ((code >> k) & 1));
+                if (++bit == 8) {
+                    out[pos++] = cur;
+                    cur = 0;
+                    bit = 0;
+                }
+            }
+        }
+        if (bit) out[pos++] = static_cast<std::uint8_t>(cur << (8 - bit));
+        return pos;
+    }
+
+    // 由范式码建出的解码树：结点下标，child[v][b] < 0 表示叶子 ~sym
+    struct Tree {
+        std::vector<int> child;  // 2 * 结点数
+        void build(const Codec& c) {
+            child.assign(2, 0);
+            for (int s = 0; s < Codec::kSymbols; ++s) {
+                const int l = c.length(s);
+                if (!l) continue;
+                int v = 0;
+                for (int k = l - 1; k >= 0; --k) {
+                    const int b = static_cast<int>((c.code(s) >> k) & 1);
+                    int& slot = child[static_cast<std::size_t>(2 * v + b)];
+                    if (k == 0) {
+                        slot = ~s;
+                    } else {
+                        if (slot == 0) {
+                            slot = static_cast<int>(child.size() / 2);
+                            child.push_back(0);
+                            child.push_back(0);
+                        }
+                        v = child[static_cast<std::size_t>(2 * v + b)];
+                    }
+                }
+            }
+        }
+    };
+
+    // 一次一位沿树下降
+    static void decode(const Tree& t, const std::uint8_t* in, std::uint8_t* out, std::size_t n) {
+        std::size_t bitPos = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            int v = 0;
+            for (;;) {
+                const int b = (in[bitPos >> 3] >> (7 - (bitPos & 7))) & 1;
+                ++bitPos;
+                const int nx = t.child[static_cast<std::size_t>(2 * v + b)];
+                if (nx < 0) {
+                    out[i] = static_cast<std::uint8_t>(~nx);
+                    break;
+                }
+                v = nx;
+            }
+        }
+    }
+} // namespace legacy
+
+static double mbps(std::size_t bytes, double ms) { return ms > 0 ? bytes / 1e6 / (ms / 1e3) : 0.0; }
+
+static void run(const char* name, const std::vector<std::uint8_t>& data) {
+    const std::size_t n = data.size();
+    std::uint64_t freq[Codec::kSymbols];
+    Codec::countBytes(data.data(), n, freq);
+    Codec c;
+    c.build(freq);
+    const std::size_t bytes = static_cast<std::size_t>((c.encodedBits(freq) + 7) / 8);
+    std::vector<std::uint8_t> a(bytes + 8), b(bytes + 8), out(n);
+
+    bench::Timer timer;
+    const std::size_t la = legacy::encode(c, data.data(), n, a.data());
+    const double encOld = timer.ms();
+    timer.reset();
+    const std::size_t lb = c.encode(data.data(), n, b.data());
+    const double encNew = timer.ms();
+    const bool same = la == lb && std::memcmp(a.data(), b.data(), lb) == 0;
+
+    legacy::Tree tree;
+    tree.build(c);
+    timer.reset();
+    legacy::decode(tree, b.data(), out.data(), n);
+    const double decOld = timer.ms();
+    bench::consume(out[n / 2]);
+    timer.reset();
+    const bool decoded = c.decode(b.data(), lb, out.data(), n);
+    const double decNew = timer.ms();
+    const bool ok = decoded && out == data;
+
+    std::printf("== %s: %zu bytes -> %zu bytes (%.3f bits/byte, max code length %d)%s ==\n",
+                name, n, lb, 8.0 * lb / n, c.maxLength(), same && ok ? "" : "  MISMATCH");
+    std::printf("%-10s bit-by-bit %8.1f MB/s   bit buffer %8.1f MB/s   x%.2f\n",
+                "encode", mbps(n, encOld), mbps(n, encNew), encNew > 0 ? encOld / encNew : 0.0);
+    std::printf("%-10s tree walk  %8.1f MB/s   table      %8.1f MB/s   x%.2f\n",
+                "decode", mbps(n, decOld), mbps(n, decNew), decNew > 0 ? decOld / decNew : 0.0);
+}
+
+// 限长码：码长不超过表宽 kTableBits 时解码全部一次查表
+static void limits(const std::vector<std::uint8_t>& data) {
+    const std::size_t n = data.size();
+    std::uint64_t freq[Codec::kSymbols];
+    Codec::countBytes(data.data(), n, freq);
+    std::uint64_t fullBits = 0;
+    for (int maxLen : {0, 15, 12, 11}) {
+        Codec c;
+        c.build(freq, maxLen);
+        const std::uint64_t bits = c.encodedBits(freq);
+        if (maxLen == 0) fullBits = bits;
+        std::vector<std::uint8_t> enc(static_cast<std::size_t>((bits + 7) / 8) + 8), out(n);
+        const std::size_t lb = c.encode(data.data(), n, enc.data());
+        bench::Timer timer;
+        const bool ok = c.decode(enc.data(), lb, out.data(), n);
+        const double ms = timer.ms();
+        std::printf("  max length %-3s -> %2d: %.4f bits/byte  loss %+.3f%%  decode %8.1f MB/s%s\n",
+                    maxLen ? std::to_string(maxLen).c_str() : "-", c.maxLength(), double(bits) / n,
+                    fullBits ? 100.0 * (double(bits) - double(fullBits)) / double(fullBits) : 0.0,
+                    mbps(n, ms), ok && out == data ? "" : "  MISMATCH");
+    }
+}
+
+int main(int argc, char** argv) {
+    const std::size_t n = static_cast<std::size_t>(bench::argOr(argc, argv, 16 << 20));
+    bench::Rng rng(5);
+    std::vector<std::uint8_t> data(n);
+
+    for (auto& x : data) x = static_cast<std::uint8_t>(rng.next());
+    run("uniform bytes", data);
+
+    // 类文本：空格与小写字母占大头，其余字节偶尔出现
+    static const char kCommon[] = "      eeeeeeetttttaaaaooooiiiinnnnsssshhhrrrdddlllcumwfgypbvk";
+    for (auto& x : data) {
+        const int r = rng.below(100);
+        x = r < 95 ? static_cast<std::uint8_t>(kCommon[rng.below(static_cast<int>(sizeof(kCommon) - 1))])
+                   : static_cast<std::uint8_t>(rng.next());
+    }
+    run("text-like", data);
+    limits(data);
+
+    // 几何分布：字节 k 的概率约 2^-(k+1)，码长随 k 线性增长，超过表宽的长码占一小部分
+    for (auto& x : data) {
+        std::uint64_t r = rng.next();
+        int k = 0;
+        while ((r & 1) && k < 40) { r >>= 1; ++k; }
+        x = static_cast<std::uint8_t>(k);
+    }
+    run("geometric", data);
+    limits(data);
+    return 0;
+}
@@ -0,0 +1,77 @@
+//
+// Created by xiang on 26-10-17.
+//
+// 哈夫曼建树基准：每次合并都扫两遍森林的旧实现（O(n²)） 对比 堆（O(n log n)） 对比 双队列（有序输入，O(n)）
+// 规模 10^4 ~ 10^6 个权值；旧实现是平方级，只在 n <= 3·10^4 时跑。
+//
+
+#include "bench_util.h"
+#include "huffman.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace legacy {
+    // 改造前 Huffman::buildFromWeights 的选择方式（同样的结点数，每次合并线性扫描两遍）
+    static ds::BTNode* build(ds::Huffman& h, const int* w, int n) {
+        std::vector<ds::BTNode*> forest(static_cast<std::size_t>(n));
+        for (int i = 0; i < n; ++i) forest[static_cast<std::size_t>(i)] = h.makeNode(w[i]);
+        int m = n;
+        while (m > 1) {
+            int i1 = -1, i2 = -1;
+            for (int i = 0; i < m; ++i)
+                if (i1 == -1 || forest[i]->key < forest[i1]->key) i1 = i;
+            for (int i = 0; i < m; ++i)
+                if (i != i1 && (i2 == -1 || forest[i]->key < forest[i2]->key)) i2 = i;
+            if (i1 > i2) std::swap(i1, i2);
+            ds::BTNode* p = h.makeNode(forest[i1]->key + forest[i2]->key);
+            p->left = forest[i1];
+            p->right = forest[i2];
+            forest[i1] = p;
+            forest[i2] = forest[m - 1];
+            --m;
+        }
+        return forest[0];
+    }
+} // namespace legacy
+
+using Mode = ds::Huffman::BuildMode;
+
+static double timeNew(const std::vector<int>& w, Mode mode) {
+    ds::Huffman h;
+    bench::Timer timer;
+    h.buildFromWeights(w.data(), static_cast<int>(w.size()), mode);
+    const double ms = timer.ms();
+    bench::consume(h.root() ? h.root()->key : 0);
+    return ms;
+}
+
+static double timeLegacy(const std::vector<int>& w) {
+    ds::Huffman h;
+    bench::Timer timer;
+    h.rootNode = legacy::build(h, w.data(), static_cast<int>(w.size()));
+    const double ms = timer.ms();
+    bench::consume(h.root()->key);
+    return ms;
+}
+
+int main(int argc, char** argv) {
+    const long long maxN = bench::argOr(argc, argv, 1000000);
+    for (int n : {10000, 30000, 100000, 300000, 1000000}) {
+        if (n > maxN) break;
+        std::vector<int> w(static_cast<std::size_t>(n));
+        bench::Rng rng(13);
+        for (int& x : w) x = 1 + rng.below(1000);  // 权值和不超过 int
+
+        std::printf("== n=%d ==\n", n);
+        const bool legacyOk = n <= 30000;
+        bench::row("random weights", n, legacyOk ? timeLegacy(w) : 0.0, timeNew(w, Mode::Heap), "scan", "heap");
+
+        std::sort(w.begin(), w.end());
+        const double heapSorted = timeNew(w, Mode::Heap);
+        bench::row("sorted weights", n, legacyOk ? timeLegacy(w) : 0.0, heapSorted, "scan", "heap");
+        bench::row("sorted weights", n, heapSorted, timeNew(w, Mode::TwoQueue), "heap", "two-queue");
+    }
+    return 0;
+}
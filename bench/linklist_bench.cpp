@@ -0,0 +1,116 @@
+//
+// Created by xiang on 26-10-17.
+//
+// 单链表基准：逐结点 malloc/free 的旧实现 对比 结点池版 ds::Linklist
+// 场景：建立 n 个结点 → 清空 → 再建立（模拟动画重播），以及一次完整遍历；
+//       另测 for(i) get(i) 导出整表（旧实现 O(n^2)，手指缓存后 O(n)）
+//       以及反复删除尾结点：单链表每次都要找前驱 O(n)，ds::DLinklist 为 O(1)
+//
+
+#include "bench_util.h"
+#include "linklist.h"
+#include "dlinklist.h"
+
+#include <cstdio>
+
+namespace legacy {
+    // 结点池之前的 ds::Linklist（只保留基准用到的部分）
+    class Linklist {
+        ds::LLNode *head; ds::LLNode *tail; int length;
+    public:
+        Linklist() : head(nullptr), tail(nullptr), length(0) {}
+        ~Linklist() { clear(); }
+        int size() const { return length; }
+        ds::LLNode* gethead() const { return head; }
+        void clear() {
+            ds::LLNode* p = head;
+            while (p) { ds::LLNode* q = p->next; std::free(p); p = q; }
+            head = tail = nullptr; length = 0;
+        }
+        int get(int position) const {
+            if (position < 0 || position >= length) return 0;
+            int i = 0; ds::LLNode* p = head;
+            while (p && i < position) { p = p->next; ++i; }
+            return p ? p->value : 0;
+        }
+        void push_back(int value) {
+            ds::LLNode* p = static_cast<ds::LLNode*>(std::malloc(sizeof(ds::LLNode)));
+            if (!p) return;
+            p->value = value; p->next = nullptr;
+            if (!tail) head = tail = p; else { tail->next = p; tail = p; }
+            ++length;
+        }
+    };
+} // namespace legacy
+
+struct Times { double build, clear, rebuild, walk; };
+
+template <typename L>
+static Times run(int n) {
+    Times r{};
+    L l;
+    bench::Timer t;
+    for (int i = 0; i < n; ++i) l.push_back(i);
+    r.build = t.ms();
+
+    t.reset();
+    l.clear();
+    r.clear = t.ms();
+
+    t.reset();
+    for (int i = 0; i < n; ++i) l.push_back(i);
+    r.rebuild = t.ms();
+
+    t.reset();
+    long long s = 0;
+    for (ds::LLNode* p = l.gethead(); p; p = p->next) s += p->value;
+    bench::consume(s);
+    r.walk = t.ms();
+    return r;
+}
+
+int main(int argc, char** argv) {
+    const long long maxN = bench::argOr(argc, argv, 10000000);
+    for (long long n = 100000; n <= maxN; n *= 10) {
+        const int ni = static_cast<int>(n);
+        const Times a = run<legacy::Linklist>(ni);
+        const Times b = run<ds::Linklist>(ni);
+        bench::row("build", n, a.build, b.build);
+        bench::row("clear", n, a.clear, b.clear);
+        bench::row("rebuild after clear", n, a.rebuild, b.rebuild);
+        bench::row("walk", n, a.walk, b.walk);
+    }
+
+    std::printf("== dump by index: for (i) get(i) ==\n");
+    for (int n : {10000, 30000, 100000}) {
+        auto dump = [n](auto& l) {
+            for (int i = 0; i < n; ++i) l.push_back(i);
+            bench::Timer t;
+            long long s = 0;
+            for (int i = 0; i < l.size(); ++i) s += l.get(i);
+            bench::consume(s);
+            return t.ms();
+        };
+        legacy::Linklist a;
+        ds::Linklist b;
+        // 旧实现是平方级，规模大时只跑新实现
+        const double legacyMs = (n <= 30000) ? dump(a) : 0.0;
+        bench::row("get(i) dump", n, legacyMs, dump(b));
+    }
+
+    std::printf("== erase tail until empty ==\n");
+    for (int n : {10000, 30000, 1000000}) {
+        auto drain = [n](auto& l) {
+            for (int i = 0; i < n; ++i) l.push_back(i);
+            bench::Timer t;
+            while (l.size() > 0) l.erase(l.size() - 1);
+            return t.ms();
+        };
+        ds::Linklist a;
+        ds::DLinklist b;
+        // 单链表删尾是平方级，规模大时只跑双链表
+        const double singlyMs = (n <= 30000) ? drain(a) : 0.0;
+        bench::row("erase(size-1) drain", n, singlyMs, drain(b), "singly", "doubly");
+    }
+    return 0;
+}
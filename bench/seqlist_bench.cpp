@@ -0,0 +1,138 @@
+//
+// Created by xiang on 26-10-17.
+//
+// 顺序表基准：旧版 int 顺序表（malloc + 逐元素拷贝/挪位）对比 ds::Seqlist<T>（realloc + memmove）
+//
+
+#include "bench_util.h"
+#include "seqlist.h"
+
+#include <cstdio>
+#include <string>
+
+namespace legacy {
+    // 模板化之前的 ds::Seqlist，原样保留作对照
+    class Seqlist {
+        int *a; int n; int cap;
+        void grow(int want) {
+            int c = (cap > 0) ? cap * 2 : 8;
+            if (c < want) c = want;
+            int *p = static_cast<int*>(std::malloc(sizeof(int) * c));
+            if (!p) return;
+            for (int i = 0; i < n; ++i) p[i] = a[i];
+            if (a) std::free(a);
+            a = p; cap = c;
+        }
+    public:
+        Seqlist() : a(nullptr), n(0), cap(0) {}
+        ~Seqlist() { if (a) std::free(a); }
+        int size() const { return n; }
+        bool insert(int position, int value) {
+            if (position < 0 || position > n) return false;
+            if (n + 1 > cap) grow(n + 1);
+            if (n + 1 > cap) return false;
+            for (int i = n; i > position; --i) a[i] = a[i - 1];
+            a[position] = value; ++n;
+            return true;
+        }
+        bool erase(int position) {
+            if (position < 0 || position >= n) return false;
+            for (int i = position; i < n - 1; ++i) a[i] = a[i + 1];
+            --n;
+            return true;
+        }
+        int get(int position) const { return (position < 0 || position >= n) ? 0 : a[position]; }
+    };
+} // namespace legacy
+
+template <typename L>
+static double appendRun(int n) {
+    bench::Timer t;
+    L l;
+    for (int i = 0; i < n; ++i) l.insert(l.size(), i);
+    bench::consume(l.get(n - 1));
+    return t.ms();
+}
+
+template <typename L>
+static double middleRun(int n, int ops) {
+    L l;
+    for (int i = 0; i < n; ++i) l.insert(l.size(), i);
+    bench::Rng rng(42);
+    bench::Timer t;
+    for (int k = 0; k < ops; ++k) {
+        l.insert(rng.below(l.size() + 1), k);
+        l.erase(rng.below(l.size()));
+    }
+    bench::consume(l.get(0));
+    return t.ms();
+}
+
+int main(int argc, char** argv) {
+    const long long maxN = bench::argOr(argc, argv, 10000000);
+
+    std::printf("== append to tail ==\n");
+    for (long long n = 1000000; n <= maxN; n *= 10) {
+        const int ni = static_cast<int>(n);
+        bench::row("append", n, appendRun<legacy::Seqlist>(ni), appendRun<ds::Seqlist<int>>(ni));
+    }
+
+    std::printf("== random insert+erase pairs (200) ==\n");
+    for (long long n = 1000000; n <= maxN; n *= 10) {
+        const int ni = static_cast<int>(n);
+        bench::row("insert/erase middle", n, middleRun<legacy::Seqlist>(ni, 200), middleRun<ds::Seqlist<int>>(ni, 200));
+    }
+
+    // 查询：逐个 get() 扫描 对比 各档 SIMD 内核
+    std::printf("== queries over Seqlist<int> (find miss / count / min+max / sum) ==\n");
+    {
+        const int n = static_cast<int>(maxN);
+        ds::Seqlist<int> l;
+        l.reserve(n);
+        bench::Rng rng(7);
+        for (int i = 0; i < n; ++i) l.insert(i, rng.below(1000000));
+
+        bench::Timer t;
+        long long acc = 0;
+        int lo = l.get(0), hi = l.get(0), hits = 0, first = -1;
+        for (int i = 0; i < l.size(); ++i) {
+            const int v = l.get(i);
+            if (first < 0 && v == -1) first = i;
+            hits += (v == 42);
+            if (v < lo) lo = v;
+            if (v > hi) hi = v;
+            acc += v;
+        }
+        bench::consume(acc + lo + hi + hits + first);
+        const double getLoop = t.ms();
+
+        const ds::simd::Level levels[] = { ds::simd::Level::Scalar, ds::simd::Level::SSE42, ds::simd::Level::AVX2 };
+        for (ds::simd::Level lv : levels) {
+            if (static_cast<int>(lv) > static_cast<int>(ds::simd::detected())) continue;
+            ds::simd::forceLevel(lv);
+            t.reset();
+            int mn = 0, mx = 0;
+            bench::consume(l.find(-1));
+            bench::consume(l.count(42));
+            l.min(&mn); l.max(&mx);
+            bench::consume(mn + mx);
+            bench::consume(l.sum());
+            char name[40];
+            std::snprintf(name, sizeof(name), "kernels %s", ds::simd::levelName(lv));
+            bench::row(name, n, getLoop, t.ms(), "get()", "kernels");
+        }
+        ds::simd::forceLevel(ds::simd::detected());
+    }
+
+    // 非平凡类型走移动构造路径，只报告新实现的耗时
+    std::printf("== Seqlist<std::string> append (move path) ==\n");
+    {
+        const int n = static_cast<int>(maxN < 1000000 ? maxN : 1000000);
+        bench::Timer t;
+        ds::Seqlist<std::string> l;
+        for (int i = 0; i < n; ++i) l.insert(l.size(), std::string("value-") + std::to_string(i));
+        bench::consume(l.get(n - 1).size());
+        std::printf("%-28s n=%-10d new %10.2f ms\n", "append string", n, t.ms());
+    }
+    return 0;
+}
@@ -0,0 +1,114 @@
+//
+// Created by xiang on 26-10-17.
+//
+// 栈基准：倍增扩容的 ds::Stack 对比 分段的 ds::ChunkedStack
+// 逐次记录每个 push/pop 的耗时，输出 p50 / p99 / p99.99 / max，
+// 倍增栈的搬移停顿会出现在尾部分位与 max 上；另给出出栈后仍占用的内存。
+//
+
+#include "bench_util.h"
+#include "stack.h"
+#include "chunkedstack.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+struct Latency { double p50, p99, p9999, maxNs, totalMs; };
+
+static Latency summarize(std::vector<std::uint32_t>& ns) {
+    Latency r{};
+    if (ns.empty()) return r;
+    auto at = [&ns](double q) {
+        const std::size_t k = static_cast<std::size_t>(q * static_cast<double>(ns.size() - 1));
+        std::nth_element(ns.begin(), ns.begin() + static_cast<std::ptrdiff_t>(k), ns.end());
+        return static_cast<double>(ns[k]);
+    };
+    double total = 0;
+    for (std::uint32_t x : ns) total += x;
+    r.totalMs = total / 1e6;
+    r.maxNs = static_cast<double>(*std::max_element(ns.begin(), ns.end()));
+    r.p50 = at(0.50);
+    r.p99 = at(0.99);
+    r.p9999 = at(0.9999);
+    return r;
+}
+
+static void print(const char* name, const char* label, long long n, const Latency& l) {
+    std::printf("%-10s %-8s n=%-10lld p50 %6.0f ns   p99 %6.0f ns   p99.99 %8.0f ns   max %10.0f ns   sum %8.2f ms\n",
+                name, label, n, l.p50, l.p99, l.p9999, l.maxNs, l.totalMs);
+}
+
+template <typename S>
+static void run(const char* label, int n) {
+    std::vector<std::uint32_t> ns(static_cast<std::size_t>(n));
+    S s;
+
+    for (int i = 0; i < n; ++i) {
+        const auto t0 = Clock::now();
+        s.push(i);
+        ns[static_cast<std::size_t>(i)] = static_cast<std::uint32_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count());
+    }
+    print("push", label, n, summarize(ns));
+
+    int out = 0;
+    for (int i = 0; i < n; ++i) {
+        const auto t0 = Clock::now();
+        s.pop(&out);
+        ns[static_cast<std::size_t>(i)] = static_cast<std::uint32_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count());
+    }
+    bench::consume(out);
+    print("pop", label, n, summarize(ns));
+}
+
+int main(int argc, char** argv) {
+    const long long maxN = bench::argOr(argc, argv, 10000000);
+    for (long long n = 100000; n <= maxN; n *= 10) {
+        const int ni = static_cast<int>(n);
+        run<ds::Stack>("doubling", ni);
+        run<ds::ChunkedStack<>>("chunked", ni);
+    }
+
+    // 在段边界上来回 push/pop：空闲段留一段时不会反复申请/释放
+    std::printf("== push/pop across a segment boundary ==\n");
+    {
+        const int rounds = 2000000;
+        auto saw = [rounds](auto& s) {
+            for (int i = 0; i < ds::ChunkedStack<>::segmentCapacity() - 1; ++i) s.push(i);
+            bench::Timer t;
+            int out = 0;
+            for (int k = 0; k < rounds; ++k) { s.push(k); s.push(k); s.pop(&out); s.pop(&out); }
+            bench::consume(out);
+            return t.ms();
+        };
+        ds::Stack a;
+        ds::ChunkedStack<> b, c;
+        c.setIdleLimit(0);
+        const double base = saw(a);
+        bench::row("boundary saw idle=1", rounds, base, saw(b), "doubling", "chunked");
+        bench::row("boundary saw idle=0", rounds, base, saw(c), "doubling", "chunked");
+    }
+
+    // 出栈后的占用：倍增栈保留峰值容量，分段栈按收缩策略归还
+    std::printf("== memory after push n / pop n ==\n");
+    {
+        const int n = 1000000;
+        ds::ChunkedStack<> s;
+        for (int i = 0; i < n; ++i) s.push(i);
+        const std::size_t peak = s.memoryBytes();
+        int out = 0;
+        while (s.pop(&out)) {}
+        bench::consume(out);
+        std::printf("chunked: peak %zu KiB, after pop %zu KiB (%d idle segment)\n",
+                    peak / 1024, s.memoryBytes() / 1024, s.idleSegments());
+        std::printf("doubling: keeps its peak capacity (>= %zu KiB) until destroyed\n",
+                    static_cast<std::size_t>(n) * sizeof(int) / 1024);
+    }
+    return 0;
+}
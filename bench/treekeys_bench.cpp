@@ -0,0 +1,143 @@
+//
+// Created by xiang on 26-10-17.
+//
+// 不同键类型下的 BST / AVL：int 对比 int64_t、短字符串（9 个字符，落在 std::string 的短串缓冲里）
+// 同一串随机数换成三种键，n 个随机插入、n 次查找（一半命中；AVL 用 lower_bound）、删除一半；倍数 < 1 表示比 int 慢。
+// int 实例与改成模板前的代码相同，可以和 bst_bench / avl_bench 的结果对照。
+// 最后用一个没有默认构造函数的键把 BST 的整批建树 + DSW balance() 跑一遍：键只要求可拷贝、可比较。
+//
+
+#include "bench_util.h"
+#include "avl.h"
+#include "binarysearchtree.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+struct Times { double insert, find, erase; };
+
+template <typename K> K makeKey(std::uint32_t r);
+template <> int makeKey<int>(std::uint32_t r) { return static_cast<int>(r >> 1); }
+template <> std::int64_t makeKey<std::int64_t>(std::uint32_t r) { return (static_cast<std::int64_t>(r) << 31) ^ 0x5bd1e995; }
+template <> std::string makeKey<std::string>(std::uint32_t r) {
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "k%08x", r);
+    return buf;
+}
+
+// keys：要插入的键；probes：查找用的键（一半是 keys 里的）
+template <typename Tree, typename K>
+static Times run(const std::vector<K>& keys, const std::vector<K>& probes) {
+    Tree t;
+    Times r{};
+    bench::Timer timer;
+    for (const K& k : keys) t.insert(k);
+    r.insert = timer.ms();
+
+    int hits = 0;
+    timer.reset();
+    for (const K& k : probes) {
+        if constexpr (requires { t.find(k); }) {
+            hits += t.find(k) != nullptr;
+        } else {
+            const auto it = t.lower_bound(k);  // AVL 没有 find
+            hits += it != t.end() && *it == k;
+        }
+    }
+    r.find = timer.ms();
+    bench::consume(hits);
+
+    timer.reset();
+    for (std::size_t i = 0; i < keys.size(); i += 2) {
+        if constexpr (requires { t.eraseKey(keys[i]); }) t.eraseKey(keys[i]);
+        else t.erase(keys[i]);
+    }
+    r.erase = timer.ms();
+    bench::consume(t.count());
+    return r;
+}
+
+template <typename K>
+static void keySet(int n, std::uint64_t seed, std::vector<K>& keys, std::vector<K>& probes) {
+    bench::Rng rng(seed);
+    keys.clear();
+    probes.clear();
+    for (int i = 0; i < n; ++i) keys.push_back(makeKey<K>(static_cast<std::uint32_t>(rng.next())));
+    for (int i = 0; i < n; ++i) {
+        probes.push_back((i & 1) ? keys[static_cast<std::size_t>(rng.below(n))]
+                                 : makeKey<K>(static_cast<std::uint32_t>(rng.next())));
+    }
+}
+
+// 只有显式构造函数的键（不能默认构造）
+struct Tag {
+    explicit Tag(int x) : v(x) {}
+    int v;
+    bool operator<(const Tag& o) const { return v < o.v; }
+};
+
+// 有序键按插入形状建树（一条右斜链），再 balance() 压成完全平衡，返回耗时
+template <typename K>
+static double balanceChain(const std::vector<K>& sorted, int& height) {
+    ds::BasicBinarySearchTree<K> t;
+    t.bulkLoad(sorted.data(), static_cast<int>(sorted.size()), ds::BasicBinarySearchTree<K>::LoadMode::InsertionOrder);
+    bench::Timer timer;
+    t.balance();
+    const double ms = timer.ms();
+    height = t.height();
+    return ms;
+}
+
+static void balanceNoDefaultKey(int n) {
+    std::vector<int> ki;
+    std::vector<Tag> kt;
+    ki.reserve(static_cast<std::size_t>(n));
+    kt.reserve(static_cast<std::size_t>(n));
+    for (int i = 0; i < n; ++i) {
+        ki.push_back(i);
+        kt.emplace_back(i);
+    }
+    int hi = 0, ht = 0;
+    const double ti = balanceChain(ki, hi);
+    const double tt = balanceChain(kt, ht);
+    bench::row("bst balance chain", n, ti, tt, "int", "tag");
+    if (hi != ht) std::printf("   MISMATCH: height %d / %d\n", hi, ht);
+}
+
+// 一种树在三种键上各跑一遍，按 int 的时间做对照
+template <template <typename, typename> class Tree>
+static void compare(const char* name, int n) {
+    std::vector<int> ki, pi;
+    std::vector<std::int64_t> kl, pl;
+    std::vector<std::string> ks, ps;
+    keySet(n, 23, ki, pi);
+    keySet(n, 23, kl, pl);
+    keySet(n, 23, ks, ps);
+
+    const Times ti = run<Tree<int, std::less<int>>>(ki, pi);
+    const Times tl = run<Tree<std::int64_t, std::less<std::int64_t>>>(kl, pl);
+    const Times ts = run<Tree<std::string, std::less<std::string>>>(ks, ps);
+
+    char label[64];
+    const struct { const char* op; double Times::*field; } ops[] = {
+        {"insert", &Times::insert}, {"find", &Times::find}, {"erase half", &Times::erase}};
+    for (const auto& op : ops) {
+        std::snprintf(label, sizeof(label), "%s %s", name, op.op);
+        bench::row(label, n, ti.*op.field, tl.*op.field, "int", "int64");
+        bench::row(label, n, ti.*op.field, ts.*op.field, "int", "string");
+    }
+}
+
+int main(int argc, char** argv) {
+    const long long maxN = bench::argOr(argc, argv, 1000000);
+    for (int n : {10000, 100000, 1000000}) {
+        if (n > maxN) break;
+        std::printf("== n=%d ==\n", n);
+        compare<ds::BasicBinarySearchTree>("bst", n);
+        compare<ds::BasicAVL>("avl", n);
+    }
+    balanceNoDefaultKey(maxN < 100000 ? static_cast<int>(maxN) : 100000);
+    return 0;
+}
@@ -0,0 +1,67 @@
+//
+// Created by xiang on 26-10-17.
+//
+// 块状链表基准：ds::Linklist（每结点一个值） 对比 ds::UnrolledLinklist（每块 1/4 条缓存行）
+// 指标：顺序建立、整表遍历吞吐、按位置随机插入/删除、结点内存占用
+//
+
+#include "bench_util.h"
+#include "linklist.h"
+#include "unrolledlinklist.h"
+
+#include <cstdio>
+
+struct Result { double build, walk, mid; std::size_t bytes; };
+
+template <typename L>
+static Result run(int n, int midOps) {
+    Result r{};
+    L l;
+    bench::Timer t;
+    for (int i = 0; i < n; ++i) l.push_back(i);
+    r.build = t.ms();
+
+    t.reset();
+    long long s = 0;
+    for (int round = 0; round < 5; ++round)
+        for (int v : l) s += v;
+    bench::consume(s);
+    r.walk = t.ms() / 5;
+
+    bench::Rng rng(3);
+    t.reset();
+    for (int k = 0; k < midOps; ++k) {
+        l.insert(rng.below(l.size() + 1), k);
+        l.erase(rng.below(l.size()));
+    }
+    r.mid = t.ms();
+    return r;
+}
+
+template <typename U>
+static void compare(const char* tag, int n, int midOps) {
+    const Result a = run<ds::Linklist>(n, midOps);
+    const Result b = run<U>(n, midOps);
+
+    U probe;
+    for (int i = 0; i < n; ++i) probe.push_back(i);
+    const double nodeBytes = static_cast<double>(sizeof(ds::LLNode));
+    const double blockBytes = static_cast<double>(probe.memoryBytes()) / n;
+
+    std::printf("-- %s (block capacity %d) --\n", tag, U::blockCapacity());
+    bench::row("build", n, a.build, b.build, "linklist", "unrolled");
+    bench::row("walk (per pass)", n, a.walk, b.walk, "linklist", "unrolled");
+    bench::row("random insert+erase", n, a.mid, b.mid, "linklist", "unrolled");
+    std::printf("%-28s n=%-10d linklist %7.2f B/elem  unrolled %7.2f B/elem\n", "node memory", n, nodeBytes, blockBytes);
+}
+
+int main(int argc, char** argv) {
+    const long long maxN = bench::argOr(argc, argv, 1000000);
+    for (long long n = 10000; n <= maxN; n *= 10) {
+        const int ni = static_cast<int>(n);
+        const int midOps = 200;
+        compare<ds::UnrolledLinklist<1>>("1 cache line", ni, midOps);
+        compare<ds::UnrolledLinklist<4>>("4 cache lines", ni, midOps);
+    }
+    return 0;
+}
@@ -4,74 +4,323 @@
 #ifndef BINARYSEARCHTREE_H
 #define BINARYSEARCHTREE_H
 #include "binarytree.h"
+#include "eytzinger.h"
+#include <algorithm>
 #include <cstdlib>
 namespace ds {
-    class BinarySearchTree : public BinaryTree {
-        static BTNode* insertNode(BTNode* root, int key) {
-            if (!root) return buildNode(key);
-            if (key < root->key) root->left = insertNode(root->left, key);
-            else if (key > root->key) root->right = insertNode(root->right, key);
-            // 等于时不插入，保持 BST 不含重复
-            return root;
-        }
+    template <typename Key, typename Compare = std::less<Key>>
+    class BasicBinarySearchTree : public BasicBinaryTree<Key, Compare> {
+        using Base = BasicBinaryTree<Key, Compare>;
 
-        static BTNode* findMin(BTNode* root) {
-            if (!root) return nullptr;
-            while (root->left) root = root->left;
-            return root;
+    public:
+        using Node = typename Base::Node;
+        using KeyParam = typename Base::KeyParam;
+        using InorderIterator = typename Base::InorderIterator;
+        using InorderRange = typename Base::InorderRange;
+        using Base::rootNode;
+        using Base::clear;
+        using Base::count;
+
+        // 删除有两个孩子的结点时的做法
+        enum class EraseMode {
+            Successor,      // 默认：摘下右子树的最小结点（中序后继）顶替被删结点，删除不会让树变高
+            LegacyJoinMax   // 旧做法：把右子树整棵接到左子树最大结点下面，反复删除后树高会不断增长
+        };
+
+        // bulkLoad 的建树方式
+        enum class LoadMode {
+            InsertionOrder, // 与按数组顺序逐个 insert 得到的形状完全相同（重复键只保留第一次）
+            Balanced        // 完全平衡：排序去重后取中点为根
+        };
+
+    protected:
+        using PathStack = typename Base::PathStack;
+        using Base::comp_;
+        using Base::order;
+        using Base::buildNode;
+        using Base::freeNode;
+        using Base::pull;
+        using Base::postorderWalk;
+        using Base::selectNode;
+        using Base::countBelow;
+
+    private:
+        EraseMode eraseMode_ = EraseMode::Successor;
+
+        // 自底向上重算路径上（栈中 mark 以上）结点的增广信息
+        static void pullPath(PathStack& path, int mark = 0) {
+            while (path.size() > mark) {
+                pull(path.top());
+                path.pop();
+            }
         }
 
-        static BTNode* findMax(BTNode* root) {
+        static Node* findMax(Node* root) {
             if (!root) return nullptr;
             while (root->right) root = root->right;
             return root;
         }
 
-        static BTNode* erase(BTNode* root, int key) {
-            if (!root) return nullptr;
+        // 非递归插入：link 指向“应当改写的那根孩子指针”，一路下降只记路径，最后只改一根指针
+        void insertNode(Node*& root, KeyParam key) {
+            PathStack path;
+            Node** link = &root;
+            while (Node* p = *link) {
+                const int c = order(key, p->key);
+                if (c == 0) return;  // 等于时不插入，保持 BST 不含重复
+                if (!path.push(p)) return;
+                link = c < 0 ? &p->left : &p->right;
+            }
+            *link = buildNode(key);
+            if (*link) pullPath(path);
+        }
 
-            if (key < root->key) root->left = erase(root->left, key);
-            else if (key > root->key) root->right = erase(root->right, key);
-            else {
-                // 找到要删除的结点
-                if (!root->left && !root->right) {
-                    std::free(root);
-                    return nullptr;
-                } else if (!root->left) {
-                    BTNode* temp = root->right;
-                    std::free(root);
-                    return temp;
-                } else if (!root->right) {
-                    BTNode* temp = root->left;
-                    std::free(root);
-                    return temp;
-                } else {
-                    // 两个孩子：把左子树的最大结点接到右子树前面
-                    BTNode* L = root->left;
-                    BTNode* R = root->right;
-                    BTNode* p = findMax(L);
-                    p->right = R;
-                    std::free(root);
-                    return L;
+        // 非递归删除，两个孩子时的做法见 EraseMode
+        void erase(Node*& root, KeyParam key, EraseMode mode) {
+            PathStack path;
+            Node** link = &root;
+            while (Node* p = *link) {
+                const int c = order(key, p->key);
+                if (c == 0) break;
+                if (!path.push(p)) return;
+                link = c < 0 ? &p->left : &p->right;
+            }
+            Node* t = *link;
+            if (!t) return;
+
+            if (!t->left || !t->right) {
+                // 叶子或单孩子：孩子直接顶上来
+                *link = t->left ? t->left : t->right;
+            } else if (mode == EraseMode::Successor) {
+                // 两个孩子：中序后继 s 摘下来顶替 t（只改指针，结点本身不动）
+                const int mark = path.size();
+                Node** slink = &t->right;
+                while ((*slink)->left) {
+                    if (!path.push(*slink)) return;
+                    slink = &(*slink)->left;
                 }
+                Node* s = *slink;
+                *slink = s->right;
+                s->left = t->left;
+                s->right = t->right;
+                *link = s;
+                pullPath(path, mark);  // 先更新 t->right 到 s 父结点的一段
+                pull(s);
+            } else {
+                // 两个孩子（旧做法）：把左子树的最大结点接到右子树前面
+                Node* L = t->left;
+                Node* R = t->right;
+                findMax(L)->right = R;
+                pullRightSpine(L, R);
+                *link = L;
+            }
+            freeNode(t);
+            pullPath(path);
+        }
+
+        // 按键排序（键相同按下标），已经严格递增时不用排
+        // 小的平凡类型（int、int64_t 等）按值放进数组里排；其余的键只排指向输入数组的指针，不拷贝键
+        static constexpr bool kKeyByValue = std::is_trivially_copyable_v<Key> && sizeof(Key) <= 2 * sizeof(void*);
+        struct KeyIndex {
+            std::conditional_t<kKeyByValue, Key, const Key*> ref;
+            int index;
+            const Key& key() const {
+                if constexpr (kKeyByValue) return ref;
+                else return *ref;
+            }
+        };
+        static KeyIndex keyIndex(const Key* a, int i) {
+            if constexpr (kKeyByValue) return KeyIndex{a[i], i};
+            else return KeyIndex{a + i, i};
+        }
+        int sortUnique(KeyIndex* a, int n) const {
+            bool sorted = true;
+            for (int i = 1; i < n && sorted; ++i) sorted = comp_(a[i - 1].key(), a[i].key());
+            if (!sorted) {
+                std::sort(a, a + n, [this](const KeyIndex& x, const KeyIndex& y) {
+                    if (comp_(x.key(), y.key())) return true;
+                    if (comp_(y.key(), x.key())) return false;
+                    return x.index < y.index;
+                });
+            }
+            int m = 0;
+            for (int i = 0; i < n; ++i) {
+                // 同键保留下标最小（最先插入）的
+                if (m == 0 || comp_(a[m - 1].key(), a[i].key())) a[m++] = a[i];
+            }
+            return m;
+        }
+
+        // 有序数组 [lo, hi) 建完全平衡的子树；递归深度 O(log n)
+        Node* buildBalanced(const KeyIndex* a, int lo, int hi, bool& ok) {
+            if (lo >= hi || !ok) return nullptr;
+            const int mid = lo + (hi - lo) / 2;
+            Node* p = buildNode(a[mid].key());
+            if (!p) { ok = false; return nullptr; }
+            p->left = buildBalanced(a, lo, mid, ok);
+            p->right = buildBalanced(a, mid + 1, hi, ok);
+            pull(p);
+            return p;
+        }
+
+        // 按键有序、以插入下标为优先级的笛卡尔树，就是逐个插入得到的 BST：
+        // 一个单调栈维护当前的右链，每个结点进栈出栈各一次，O(n)
+        Node* buildInsertionShape(const KeyIndex* a, int m, bool& ok) {
+            Node** st = static_cast<Node**>(std::malloc(sizeof(Node*) * static_cast<std::size_t>(m)));
+            int* idx = static_cast<int*>(std::malloc(sizeof(int) * static_cast<std::size_t>(m)));
+            if (!st || !idx) {
+                std::free(st);
+                std::free(idx);
+                ok = false;
+                return nullptr;
+            }
+            int top = 0;
+            for (int i = 0; i < m; ++i) {
+                Node* x = buildNode(a[i].key());
+                if (!x) { ok = false; break; }
+                Node* last = nullptr;
+                while (top > 0 && idx[top - 1] > a[i].index) last = st[--top];
+                x->left = last;
+                if (top > 0) st[top - 1]->right = x;
+                st[top] = x;
+                idx[top++] = a[i].index;
             }
+            Node* root = top > 0 ? st[0] : nullptr;
+            std::free(st);
+            std::free(idx);
             return root;
         }
 
+        // DSW 第一步：不断右旋，把整棵树拉成一条右链（只改指针，O(n)）
+        // link 指向链上下一个结点所在的那根指针：开始是 root，之后是链尾结点的 right，不需要额外的哑结点
+        static void treeToVine(Node*& root) {
+            Node** link = &root;
+            while (Node* rest = *link) {
+                if (!rest->left) {
+                    link = &rest->right;
+                } else {
+                    Node* l = rest->left;
+                    rest->left = l->right;
+                    l->right = rest;
+                    *link = l;
+                }
+            }
+        }
+
+        // DSW 第二步：沿右链每隔一个结点左旋一次，共 count 次
+        static void compress(Node*& root, int count) {
+            Node** link = &root;
+            for (int i = 0; i < count; ++i) {
+                Node* child = *link;
+                Node* next = child->right;
+                *link = next;
+                child->right = next->left;
+                next->left = child;
+                link = &next->right;
+            }
+        }
+
+        // R 接到左子树最大结点下面后，L 的右链（到 R 为止）都变了：自底向上重算
+        static void pullRightSpine(Node* L, const Node* R) {
+            PathStack spine;
+            for (Node* q = L; q != R; q = q->right) {
+                if (!spine.push(q)) return;
+            }
+            pullPath(spine);
+        }
+
     public:
-        BinarySearchTree() : BinaryTree() {}
+        explicit BasicBinarySearchTree(const Compare& comp = Compare()) : Base(comp) { this->augmented_ = true; }
 
-        void insert(int key) { rootNode = insertNode(rootNode, key); }
-        BTNode* find(int key) {
-            BTNode* p = rootNode;
+        void insert(KeyParam key) { insertNode(rootNode, key); }
+        Node* find(KeyParam key) {
+            Node* p = rootNode;
             while (p) {
-                if (p->key == key) return p;
-                else if (key < p->key) p = p->left;
-                else p = p->right;
+                const int c = order(key, p->key);
+                if (c == 0) return p;
+                p = c < 0 ? p->left : p->right;
             }
             return nullptr;
         }
-        void eraseKey(int key) { rootNode = erase(rootNode, key); }
+        void eraseKey(KeyParam key) { erase(rootNode, key, eraseMode_); }
+
+        // 顺序统计：借助每个结点的子树大小，沿一条路径下降，O(h)（不用再 inorder 整棵树）
+        // 第 k 小的结点（k 从 1 开始），越界返回 nullptr；visit 依次收到查找路径上的结点
+        Node* select(int k) { return selectNode(rootNode, k, [](Node*) {}); }
+        template <typename Visit>
+        Node* select(int k, Visit visit) { return selectNode(rootNode, k, visit); }
+
+        // 比 key 小的键的个数（key 在树中时它就是第 rank + 1 小）
+        int rank(KeyParam key) const { return countBelow(rootNode, key, false, [](Node*) {}); }
+        template <typename Visit>
+        int rank(KeyParam key, Visit visit) const { return countBelow(rootNode, key, false, visit); }
+
+        // 落在闭区间 [lo, hi] 内的键的个数：两次 rank 相减，不需要把区间里的键取出来
+        int countRange(KeyParam lo, KeyParam hi) const {
+            if (comp_(hi, lo)) return 0;
+            return countBelow(rootNode, hi, true, [](Node*) {}) - countBelow(rootNode, lo, false, [](Node*) {});
+        }
+
+        // 中序迭代与区间扫描（见 BinaryTree::InorderIterator）：定位 O(h)，之后每步均摊 O(1)，路径不超过 64 层时不申请内存
+        InorderIterator begin() const { return InorderIterator::first(rootNode, comp_); }
+        InorderIterator end() const { return InorderIterator(); }
+        InorderIterator lower_bound(KeyParam key) const { return InorderIterator::seek(rootNode, key, false, comp_); }  // 第一个 >= key
+        InorderIterator upper_bound(KeyParam key) const { return InorderIterator::seek(rootNode, key, true, comp_); }   // 第一个 > key
+        // 闭区间 [lo, hi] 内的键，按从小到大：for (int k : t.range(lo, hi))
+        InorderRange range(KeyParam lo, KeyParam hi) const {
+            if (comp_(hi, lo)) return InorderRange{};
+            return InorderRange{lower_bound(lo), upper_bound(hi)};
+        }
+
+        // 冻结成只读的 Eytzinger 快照（替换 out 原有内容），O(n)；读多写少的阶段用它查找，不再追指针
+        // 之后对树的修改不会反映到快照里；申请内存失败返回 false。快照按 int 的 < 排列，只对 int 键的树提供
+        bool toEytzinger(EytzingerSnapshot& out) const
+            requires(std::is_same_v<Key, int> && std::is_same_v<Compare, std::less<int>>)
+        {
+            return out.assign(rootNode, count());
+        }
+
+        // 用数组 a[0..n) 一次性建树（替换原有内容），排序 O(n log n)（输入已有序时省掉）+ 建树 O(n)
+        // 逐个 insert 对有序输入是 O(n²)；申请内存失败返回 false，树为空
+        bool bulkLoad(const Key* a, int n, LoadMode mode) {
+            clear();
+            if (!a || n <= 0) return true;
+            KeyIndex* ka = static_cast<KeyIndex*>(std::malloc(sizeof(KeyIndex) * static_cast<std::size_t>(n)));
+            if (!ka) return false;
+            for (int i = 0; i < n; ++i) ka[i] = keyIndex(a, i);
+            const int m = sortUnique(ka, n);
+
+            bool ok = true;
+            if (mode == LoadMode::Balanced) {
+                rootNode = buildBalanced(ka, 0, m, ok);
+            } else {
+                rootNode = buildInsertionShape(ka, m, ok);
+                if (ok) postorderWalk(rootNode, pull);
+            }
+            std::free(ka);
+            if (!ok) clear();
+            return ok;
+        }
+
+        // 原地平衡化（Day–Stout–Warren）：先拉成右链，再分轮左旋压成完全平衡的树
+        // 只改指针，时间 O(n)，除最后重算增广信息外只用 O(1) 额外空间
+        void balance() {
+            const int n = count();
+            if (n <= 2) return;
+            treeToVine(rootNode);
+
+            int full = 1;                       // 不超过 n + 1 的最大 2 的幂
+            while (full * 2 <= n + 1) full *= 2;
+            compress(rootNode, n + 1 - full);  // 先把多出来的结点压到最底层
+            for (int m = full - 1; m > 1; m /= 2) compress(rootNode, m / 2);
+
+            postorderWalk(rootNode, pull);
+        }
+
+        void setEraseMode(EraseMode mode) { eraseMode_ = mode; }
+        EraseMode eraseMode() const { return eraseMode_; }
     };
+
+    using BinarySearchTree = BasicBinarySearchTree<int>;
 } // namespace ds
 #endif // BINARYSEARCHTREE_H
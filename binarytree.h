@@ -5,92 +5,538 @@
 #ifndef BINARYTREE_H
 #define BINARYTREE_H
 
+#include <cstddef>
 #include <cstdlib>   // malloc/free
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include "nodepool.h"
 
 namespace ds {
 
-    struct BTNode {
-        int key;
-        BTNode* left;
-        BTNode* right;
+    template <typename Key>
+    struct BasicBTNode {
+        Key key;
+        BasicBTNode* left;
+        BasicBTNode* right;
+        // 增广信息：以该结点为根的子树结点数、子树高度（叶子为 1）
+        // 只有 augmented 的树（BST、AVL）在插入/删除/旋转时维护；普通二叉树、哈夫曼树不保证其正确
+        int size;
+        int height;
     };
 
-    class BinaryTree {
-        // 递归释放
-        static void destroy(BTNode* p) {
-            if (!p) return;
-            destroy(p->left);
-            destroy(p->right);
-            std::free(p);
+    // 界面、哈夫曼树等都用 int 键
+    using BTNode = BasicBTNode<int>;
+
+    // 二叉树，按键类型 Key 和比较器 Compare（严格弱序，默认 std::less）实例化：
+    // - 键只通过 Compare 比较，“相等”指互不小于；
+    // - Key 是标量时按值传参，否则按 const 引用（见 KeyParam），int 实例生成的代码与原来的非模板版本相同；
+    // - 键不是平凡类型（例如 std::string）时，结点上的键由树负责构造/析构，clear() 因此要遍历一遍结点。
+    template <typename Key, typename Compare = std::less<Key>>
+    class BasicBinaryTree {
+    public:
+        using Node = BasicBTNode<Key>;
+        using KeyParam = std::conditional_t<std::is_scalar_v<Key>, Key, const Key&>;
+
+    private:
+        // 结点池只管原始存储，结点（键）的构造和析构由树来做
+        struct Slot {
+            alignas(Node) unsigned char bytes[sizeof(Node)];
+        };
+        static constexpr bool kTrivialKey = std::is_trivially_destructible_v<Key>;
+
+        // 结点池（arena）：本树的所有结点都从这里按块切出；整棵清空只是把池子复位，不再逐个 free
+        NodePool<Slot> pool_;
+        bool reuse_ = true;  // 删除的结点是否挂回空闲链表，供下次插入复用
+
+        // 写入遍历结果：cnt 总是计数，out 只在容量内写
+        static void emit(const Node* p, Key* out, int maxn, int& cnt) {
+            if (out && cnt < maxn) out[cnt] = p->key;
+            ++cnt;
         }
 
-        // 递归高度
-        int height(BTNode* p) const {
-            if (!p) return 0;
-            int lh = height(p->left);
-            int rh = height(p->right);
-            return (lh > rh ? lh : rh) + 1;
+        // 析构整棵树上的键（平凡类型的键什么也不做）：把左孩子不断右旋上来，沿右链逐个析构，额外空间 O(1)
+        static void destroyKeys(Node* p) {
+            if constexpr (!kTrivialKey) {
+                while (p) {
+                    if (p->left) {
+                        Node* l = p->left;
+                        p->left = l->right;
+                        l->right = p;
+                        p = l;
+                    } else {
+                        Node* r = p->right;
+                        p->~Node();
+                        p = r;
+                    }
+                }
+            }
         }
 
-        // 递归计数
-        int countRec(const BTNode* p) const {
-            if (!p) return 0;
-            return 1 + countRec(p->left) + countRec(p->right);
+    protected:
+        // 显式栈：保存从根到当前结点的路径，代替递归调用栈
+        // 前 kInline 层放在对象内部（插入/删除/遍历的常见情形不碰 malloc），更深的路径才搬到堆上按倍数扩容
+        class PathStack {
+        public:
+            static constexpr int kInline = 64;
+
+            PathStack() = default;
+            ~PathStack() { if (a != inl) std::free(a); }
+            PathStack(const PathStack&) = delete;
+            PathStack& operator=(const PathStack&) = delete;
+
+            bool push(Node* p) {
+                if (n == cap) {
+                    const int c = cap * 2;
+                    const std::size_t bytes = sizeof(Node*) * static_cast<std::size_t>(c);
+                    Node** b = static_cast<Node**>(a == inl ? std::malloc(bytes) : std::realloc(a, bytes));
+                    if (!b) return false;
+                    if (a == inl) std::memcpy(b, inl, sizeof(Node*) * static_cast<std::size_t>(n));
+                    a = b;
+                    cap = c;
+                }
+                a[n++] = p;
+                return true;
+            }
+            Node* top() const { return a[n - 1]; }
+            void pop() { --n; }
+            bool empty() const { return n == 0; }
+            int size() const { return n; }
+
+        private:
+            Node* inl[kInline];
+            Node** a = inl;
+            int n = 0, cap = kInline;
+        };
+
+        // 环形队列：层序遍历用，按需扩容，只占用“最宽一层”左右的空间
+        class NodeQueue {
+            Node** a = nullptr;
+            int head = 0, n = 0, cap = 0;
+        public:
+            NodeQueue() = default;
+            ~NodeQueue() { if (a) std::free(a); }
+            NodeQueue(const NodeQueue&) = delete;
+            NodeQueue& operator=(const NodeQueue&) = delete;
+
+            bool push(Node* p) {
+                if (n == cap) {
+                    const int c = cap > 0 ? cap * 2 : 64;
+                    Node** b = static_cast<Node**>(std::malloc(sizeof(Node*) * static_cast<std::size_t>(c)));
+                    if (!b) return false;
+                    for (int i = 0; i < n; ++i) b[i] = a[(head + i) % cap];
+                    if (a) std::free(a);
+                    a = b;
+                    head = 0;
+                    cap = c;
+                }
+                a[(head + n) % cap] = p;
+                ++n;
+                return true;
+            }
+            Node* pop() {
+                Node* p = a[head];
+                head = (head + 1) % cap;
+                --n;
+                return p;
+            }
+            bool empty() const { return n == 0; }
+        };
+
+        [[no_unique_address]] Compare comp_;
+
+        // std::less / std::greater 下的标量键，“相等”可以直接用 ==
+        static constexpr bool kNativeEq = std::is_scalar_v<Key> &&
+                (std::is_same_v<Compare, std::less<Key>> || std::is_same_v<Compare, std::greater<Key>>);
+
+        // 互不小于即相等
+        bool equivalent(KeyParam a, KeyParam b) const {
+            if constexpr (kNativeEq) return a == b;
+            else return !comp_(a, b) && !comp_(b, a);
         }
 
-        // 三种遍历递归
-        void preorderRec(const BTNode* p, int* out, int maxn, int& cnt) const {
-            if (!p) return;
-            if (out && cnt < maxn) out[cnt] = p->key;
-            ++cnt;
-            preorderRec(p->left,  out, maxn, cnt);
-            preorderRec(p->right, out, maxn, cnt);
+        // 查找下降时 key 与结点键 pk 的比较：0 相等，< 0 去左子树，> 0 去右子树
+        // 标量键先判 ==（几乎总是不等，分支好预测），左右再用一次 < 选，编译成条件传送，与原来 int 版本的代码相同；
+        // 其余键先比 key < pk，每层最多两次比较
+        int order(KeyParam key, KeyParam pk) const {
+            if constexpr (kNativeEq) return key == pk ? 0 : (comp_(key, pk) ? -1 : 1);
+            else return comp_(key, pk) ? -1 : (comp_(pk, key) ? 1 : 0);
         }
 
-        void inorderRec(const BTNode* p, int* out, int maxn, int& cnt) const {
-            if (!p) return;
-            inorderRec(p->left,  out, maxn, cnt);
-            if (out && cnt < maxn) out[cnt] = p->key;
-            ++cnt;
-            inorderRec(p->right, out, maxn, cnt);
+        // 造一个新结点（从本树的结点池里取）
+        Node* buildNode(KeyParam key) {
+            Slot* s = pool_.alloc();
+            if (!s) return nullptr;
+            return ::new (static_cast<void*>(s)) Node{key, nullptr, nullptr, 1, 1};
         }
 
-        void postorderRec(const BTNode* p, int* out, int maxn, int& cnt) const {
-            if (!p) return;
-            postorderRec(p->left,  out, maxn, cnt);
-            postorderRec(p->right, out, maxn, cnt);
-            if (out && cnt < maxn) out[cnt] = p->key;
-            ++cnt;
+        // 归还一个已经摘下来的结点：先析构键；不复用时存储留在块里，到 clear() 时随整池一起回收
+        void freeNode(Node* p) {
+            if constexpr (!kTrivialKey) p->~Node();
+            if (reuse_) pool_.release(reinterpret_cast<Slot*>(p));
         }
 
-    protected:
-        // 造一个新结点
-        static BTNode* buildNode(int key) {
-            BTNode* p = static_cast<BTNode*>(std::malloc(sizeof(BTNode)));
-            if (!p) return nullptr;
-            p->key  = key;
-            p->left = p->right = nullptr;
-            return p;
+        // 归还整棵子树（建树失败回滚用）：把左孩子不断右旋上来，沿右链逐个归还，额外空间 O(1)
+        void freeTree(Node* p) {
+            if (kTrivialKey && !reuse_) return;
+            while (p) {
+                if (p->left) {
+                    Node* l = p->left;
+                    p->left = l->right;
+                    l->right = p;
+                    p = l;
+                } else {
+                    Node* r = p->right;
+                    freeNode(p);
+                    p = r;
+                }
+            }
+        }
+
+        // 派生类在构造时置为 true，表示会维护 BTNode::size/height，count()/height() 直接读根结点
+        bool augmented_ = false;
+
+        static int sizeOf(const Node* p) { return p ? p->size : 0; }
+        static int heightOf(const Node* p) { return p ? p->height : 0; }
+        // 由左右孩子重新算出 p 的增广信息（孩子必须已经正确）
+        static void pull(Node* p) {
+            const int lh = heightOf(p->left), rh = heightOf(p->right);
+            p->size = sizeOf(p->left) + sizeOf(p->right) + 1;
+            p->height = (lh > rh ? lh : rh) + 1;
+        }
+
+        // 顺序统计（只对维护 size 的搜索树有意义），都只走一条根到叶的路径，O(h)；
+        // visit 依次收到路径上经过的结点，界面用它高亮查找路径
+        // 第 k 小的结点（k 从 1 开始），越界返回 nullptr
+        template <typename Visit>
+        static Node* selectNode(Node* root, int k, Visit visit) {
+            Node* p = root;
+            while (p) {
+                visit(p);
+                const int ls = sizeOf(p->left);
+                if (k <= ls) {
+                    p = p->left;
+                } else if (k == ls + 1) {
+                    return p;
+                } else {
+                    k -= ls + 1;
+                    p = p->right;
+                }
+            }
+            return nullptr;
+        }
+
+        // 小于 key（inclusive 时为小于等于）的键的个数
+        template <typename Visit>
+        int countBelow(Node* root, KeyParam key, bool inclusive, Visit visit) const {
+            int r = 0;
+            Node* p = root;
+            while (p) {
+                visit(p);
+                if (comp_(key, p->key)) {
+                    p = p->left;
+                } else if (!comp_(p->key, key)) {
+                    return r + sizeOf(p->left) + (inclusive ? 1 : 0);
+                } else {
+                    r += sizeOf(p->left) + 1;
+                    p = p->right;
+                }
+            }
+            return r;
         }
 
     public:
-        BTNode* rootNode;
-        BinaryTree() : rootNode(nullptr) {}
-        virtual ~BinaryTree() { clear(); }
-
-        void clear() { destroy(rootNode); rootNode = nullptr; }
-        BTNode* root() const { return rootNode; }
-        // 用层序数组建树，null 表示空结点
-        void buildTree(const int* arr, int n, int null) {
+        Node* rootNode;
+        explicit BasicBinaryTree(const Compare& comp = Compare()) : comp_(comp), rootNode(nullptr) {}
+        virtual ~BasicBinaryTree() { destroyKeys(rootNode); }  // 结点池析构时逐块 free
+        BasicBinaryTree(const BasicBinaryTree&) = delete;
+        BasicBinaryTree& operator=(const BasicBinaryTree&) = delete;
+
+        // 清空：结点池复位，不逐个释放；已申请的块留着给下一次建树直接复用
+        // 平凡类型的键 O(1)；否则先遍历一遍析构键，O(n)
+        void clear() {
+            destroyKeys(rootNode);
+            pool_.reset();
+            rootNode = nullptr;
+        }
+        // 清空并把块还给系统，O(块数)
+        void releaseMemory() {
+            destroyKeys(rootNode);
+            pool_.purge();
+            rootNode = nullptr;
+        }
+
+        // 删除的结点是否复用（默认复用）。关掉后插入总是顺序切新结点，删掉的结点直到 clear() 才回收
+        void setNodeReuse(bool on) { reuse_ = on; }
+        bool nodeReuse() const { return reuse_; }
+
+        // 结点池的占用情况
+        struct ArenaStats {
+            std::size_t bytesReserved;  // 向系统申请的字节数（按块计）
+            std::size_t bytesInUse;     // 已分出去、还没归还的结点占的字节数
+            int chunks;                 // 块数
+            int liveNodes;              // 已分出去、还没归还的结点数
+        };
+        ArenaStats arenaStats() const {
+            return ArenaStats{pool_.bytesReserved(), pool_.bytesInUse(), pool_.chunkCount(), pool_.liveNodes()};
+        }
+
+        Node* root() const { return rootNode; }
+        Compare keyComp() const { return comp_; }
+
+        // 搜索树的中序迭代器：按键从小到大逐个给出结点，是标准的前向迭代器（可以交给 std::vector 的区间构造和各种算法）
+        // - 栈里只放“向左走过”的祖先（即比当前键大、还没输出的结点），深度 O(h)；
+        // - 前 kInline 层放在对象内部，平衡的树不申请堆内存；更深的路径（退化的 BST）才搬到堆上按倍数扩容，
+        //   整趟遍历仍是 O(n)，区间扫描 O(h + k)；
+        // - 万一堆内存申请失败，丢掉最靠近根的一半，栈空了再从根按键重新下降补回来：结果不变，只是变慢，
+        //   所以这种回退只对满足 BST 次序的树成立；
+        // - 迭代过程中树不能被修改。
+        class InorderIterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = Key;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = const Key*;
+            using reference         = const Key&;
+
+            static constexpr int kInline = 64;  // AVL 的树高到不了 64；完全平衡的 BST 也一样
+
+            InorderIterator() = default;  // 等价于 end()
+            ~InorderIterator() { release(); }
+            InorderIterator(const InorderIterator& o) : comp_(o.comp_) { copyFrom(o); }
+            InorderIterator(InorderIterator&& o) noexcept : comp_(o.comp_) { moveFrom(o); }
+            InorderIterator& operator=(const InorderIterator& o) {
+                if (this != &o) {
+                    release();
+                    comp_ = o.comp_;
+                    copyFrom(o);
+                }
+                return *this;
+            }
+            InorderIterator& operator=(InorderIterator&& o) noexcept {
+                if (this != &o) {
+                    release();
+                    comp_ = o.comp_;
+                    moveFrom(o);
+                }
+                return *this;
+            }
+
+            reference operator*() const { return cur_->key; }
+            pointer operator->() const { return &cur_->key; }
+            const Node* node() const { return cur_; }
+            InorderIterator& operator++() {
+                if (cur_->right) {
+                    pushLeftSpine(cur_->right);
+                } else if (n_ == 0 && dropped_) {
+                    redescend();
+                }
+                cur_ = n_ > 0 ? st_[--n_] : nullptr;
+                return *this;
+            }
+            InorderIterator operator++(int) {
+                InorderIterator t = *this;
+                ++*this;
+                return t;
+            }
+            bool operator==(const InorderIterator& o) const { return cur_ == o.cur_; }
+            bool operator!=(const InorderIterator& o) const { return cur_ != o.cur_; }
+
+            // 最小的结点
+            static InorderIterator first(const Node* root, const Compare& comp = Compare()) {
+                InorderIterator it(root, comp);
+                it.pushLeftSpine(root);
+                it.cur_ = it.n_ > 0 ? it.st_[--it.n_] : nullptr;
+                return it;
+            }
+
+            // 第一个 key >= k（strict 时 key > k）的结点：一路下降，向左时把当前结点记为候选并入栈，O(h)
+            static InorderIterator seek(const Node* root, KeyParam k, bool strict, const Compare& comp = Compare()) {
+                InorderIterator it(root, comp);
+                for (const Node* p = root; p;) {
+                    if (strict ? comp(k, p->key) : !comp(p->key, k)) {
+                        it.push(p);
+                        p = p->left;
+                    } else {
+                        p = p->right;
+                    }
+                }
+                it.cur_ = it.n_ > 0 ? it.st_[--it.n_] : nullptr;
+                return it;
+            }
+
+        private:
+            const Node* inl_[kInline];
+            const Node** st_ = inl_;  // 栈底在 st_[0]，指向 inl_ 或堆上的数组
+            int n_ = 0, cap_ = kInline;
+            bool dropped_ = false;    // 是否因为申请内存失败丢过栈底
+            const Node* root_ = nullptr;
+            const Node* cur_ = nullptr;
+            [[no_unique_address]] Compare comp_{};
+
+            InorderIterator(const Node* root, const Compare& comp) : root_(root), comp_(comp) {}
+
+            void release() {
+                if (st_ != inl_) std::free(st_);
+                st_ = inl_;
+                cap_ = kInline;
+                n_ = 0;
+            }
+            // 调用前 *this 已 release()：深拷贝栈，申请不到内存时只留最靠上的 kInline 层，其余靠 redescend 补回
+            void copyFrom(const InorderIterator& o) {
+                root_ = o.root_;
+                cur_ = o.cur_;
+                dropped_ = o.dropped_;
+                int keep = o.n_;
+                if (keep > kInline) {
+                    auto** b = static_cast<const Node**>(std::malloc(sizeof(const Node*) * static_cast<std::size_t>(keep)));
+                    if (b) {
+                        st_ = b;
+                        cap_ = keep;
+                    } else {
+                        keep = kInline;
+                        dropped_ = true;
+                    }
+                }
+                std::memcpy(st_, o.st_ + (o.n_ - keep), sizeof(const Node*) * static_cast<std::size_t>(keep));
+                n_ = keep;
+            }
+            // 调用前 *this 已 release()：堆上的栈直接接管，内部数组只能拷贝
+            void moveFrom(InorderIterator& o) {
+                root_ = o.root_;
+                cur_ = o.cur_;
+                dropped_ = o.dropped_;
+                if (o.st_ != o.inl_) {
+                    st_ = o.st_;
+                    cap_ = o.cap_;
+                    o.st_ = o.inl_;
+                    o.cap_ = kInline;
+                } else {
+                    std::memcpy(inl_, o.inl_, sizeof(const Node*) * static_cast<std::size_t>(o.n_));
+                }
+                n_ = o.n_;
+                o.n_ = 0;
+            }
+
+            void push(const Node* p) {
+                if (n_ == cap_ && !grow()) {
+                    // 申请失败：丢掉靠近根的一半（摊到每次 push 仍是 O(1)）
+                    const int keep = n_ / 2;
+                    std::memmove(st_, st_ + (n_ - keep), sizeof(const Node*) * static_cast<std::size_t>(keep));
+                    n_ = keep;
+                    dropped_ = true;
+                }
+                st_[n_++] = p;
+            }
+            bool grow() {
+                const int c = cap_ * 2;
+                const std::size_t bytes = sizeof(const Node*) * static_cast<std::size_t>(c);
+                auto** b = static_cast<const Node**>(st_ == inl_ ? std::malloc(bytes) : std::realloc(st_, bytes));
+                if (!b) return false;
+                if (st_ == inl_) std::memcpy(b, inl_, sizeof(const Node*) * static_cast<std::size_t>(n_));
+                st_ = b;
+                cap_ = c;
+                return true;
+            }
+            void pushLeftSpine(const Node* p) {
+                for (; p; p = p->left) push(p);
+            }
+            // 从根按当前键重新下降，重建“向左走过”的祖先
+            void redescend() {
+                dropped_ = false;
+                const Key& k = cur_->key;
+                for (const Node* p = root_; p && p != cur_;) {
+                    if (comp_(k, p->key)) {
+                        push(p);
+                        p = p->left;
+                    } else {
+                        p = p->right;
+                    }
+                }
+            }
+        };
+
+        // 迭代区间 [first, last)，可以直接用在范围 for 里
+        struct InorderRange {
+            InorderIterator first, last;
+            InorderIterator begin() const { return first; }
+            InorderIterator end() const { return last; }
+        };
+
+        // ===== 非递归遍历：按次序把结点指针交给 visit（画图/导出也用它们，斜链也不会爆栈） =====
+
+        // 后序遍历（显式栈，额外空间 O(h)）：栈里始终是根到当前结点的路径，
+        // 对每个结点在左右子树都访问完之后调用 visit；返回路径的最大长度即树高
+        template <typename Visit>
+        static int postorderWalk(Node* root, Visit visit) {
+            PathStack st;
+            Node* cur = root;
+            Node* last = nullptr;
+            int maxDepth = 0;
+            while (cur || !st.empty()) {
+                if (cur) {
+                    if (!st.push(cur)) return maxDepth;
+                    if (st.size() > maxDepth) maxDepth = st.size();
+                    cur = cur->left;
+                } else {
+                    Node* p = st.top();
+                    if (p->right && last != p->right) {
+                        cur = p->right;
+                    } else {
+                        visit(p);
+                        last = p;
+                        st.pop();
+                    }
+                }
+            }
+            return maxDepth;
+        }
+
+        // 先序遍历（显式栈，额外空间 O(h)）：弹出即访问，先压右孩子再压左孩子
+        template <typename Visit>
+        static void preorderWalk(Node* root, Visit visit) {
+            if (!root) return;
+            PathStack st;
+            if (!st.push(root)) return;
+            while (!st.empty()) {
+                Node* p = st.top();
+                st.pop();
+                visit(p);
+                if (p->right && !st.push(p->right)) return;
+                if (p->left  && !st.push(p->left))  return;
+            }
+        }
+
+        // 中序遍历（显式栈，额外空间 O(h)）：一路向左压栈，弹出时访问再转向右子树
+        template <typename Visit>
+        static void inorderWalk(Node* root, Visit visit) {
+            PathStack st;
+            Node* cur = root;
+            while (cur || !st.empty()) {
+                while (cur) {
+                    if (!st.push(cur)) return;
+                    cur = cur->left;
+                }
+                Node* p = st.top();
+                st.pop();
+                visit(p);
+                cur = p->right;
+            }
+        }
+
+        // 用层序数组建树，与 null 相等的项表示空结点
+        void buildTree(const Key* arr, int n, KeyParam null) {
             clear();
             if (!arr || n <= 0) return;
-            if (arr[0] == null) {
+            if (equivalent(arr[0], null)) {
                 rootNode = nullptr;
                 return;
             }
 
-            BTNode** q = static_cast<BTNode**>(
-                    std::malloc(sizeof(BTNode*) * static_cast<std::size_t>(n)));
+            Node** q = static_cast<Node**>(
+                    std::malloc(sizeof(Node*) * static_cast<std::size_t>(n)));
             if (!q) return;
 
             int head = 0, tail = 0, idx = 1;
@@ -103,10 +549,10 @@ namespace ds {
             q[tail++] = rootNode;
 
             while (head < tail && idx < n) {
-                BTNode* p = q[head++];
+                Node* p = q[head++];
 
                 // 左孩子
-                if (idx < n && arr[idx] != null) {
+                if (idx < n && !equivalent(arr[idx], null)) {
                     p->left = buildNode(arr[idx]);
                     if (!p->left) {
                         std::free(q);
@@ -117,7 +563,7 @@ namespace ds {
                 ++idx;
 
                 // 右孩子
-                if (idx < n && arr[idx] != null) {
+                if (idx < n && !equivalent(arr[idx], null)) {
                     p->right = buildNode(arr[idx]);
                     if (!p->right) {
                         std::free(q);
@@ -128,68 +574,69 @@ namespace ds {
                 ++idx;
             }
             std::free(q);
+            if (augmented_) postorderWalk(rootNode, pull);
         }
 
-        // 高度
-        int height() const { return height(rootNode); }
+        // 高度：增广树 O(1)，否则显式栈遍历
+        int height() const {
+            if (augmented_) return heightOf(rootNode);
+            return postorderWalk(rootNode, [](Node*) {});
+        }
 
-        // 结点总数
-        int count() const { return countRec(rootNode); }
+        // 结点总数：增广树 O(1)，否则显式栈遍历
+        int count() const {
+            if (augmented_) return sizeOf(rootNode);
+            int cnt = 0;
+            preorderWalk(rootNode, [&cnt](Node*) { ++cnt; });
+            return cnt;
+        }
 
         // 先序遍历，返回写入个数；out==nullptr 或 maxn<=0 时仅返回应写入个数
-        int preorder(int* out, int maxn) const {
+        int preorder(Key* out, int maxn) const {
             int cnt = 0;
-            preorderRec(rootNode, out, maxn, cnt);
+            preorderWalk(rootNode, [&](Node* p) { emit(p, out, maxn, cnt); });
             return cnt;
         }
 
         // 中序遍历
-        int inorder(int* out, int maxn) const {
+        int inorder(Key* out, int maxn) const {
             int cnt = 0;
-            inorderRec(rootNode, out, maxn, cnt);
+            inorderWalk(rootNode, [&](Node* p) { emit(p, out, maxn, cnt); });
             return cnt;
         }
 
         // 后序遍历
-        int postorder(int* out, int maxn) const {
+        int postorder(Key* out, int maxn) const {
             int cnt = 0;
-            postorderRec(rootNode, out, maxn, cnt);
+            postorderWalk(rootNode, [&](Node* p) { emit(p, out, maxn, cnt); });
             return cnt;
         }
 
-        // 层序遍历
-        int levelorder(int* out, int maxn) const {
+        // 层序遍历：边出队边入队，不再先数一遍结点
+        int levelorder(Key* out, int maxn) const {
             if (!rootNode) return 0;
-
-            int nodeCount = count();
             if (out == nullptr || maxn <= 0) {
-                return nodeCount;
+                return count();
             }
-            if (nodeCount <= 0) return 0;
-
-            BTNode** q = static_cast<BTNode**>(
-                    std::malloc(sizeof(BTNode*) * static_cast<std::size_t>(nodeCount)));
-            if (!q) return 0;
 
-            int head = 0, tail = 0;
-            int cnt  = 0;
+            NodeQueue q;
+            if (!q.push(rootNode)) return 0;
 
-            q[tail++] = rootNode;
-
-            while (head < tail && cnt < maxn) {
-                BTNode* p = q[head++];
+            int cnt = 0;
+            while (!q.empty() && cnt < maxn) {
+                Node* p = q.pop();
 
                 out[cnt++] = p->key;
 
-                if (p->left)  q[tail++] = p->left;
-                if (p->right) q[tail++] = p->right;
+                if (p->left  && !q.push(p->left))  break;
+                if (p->right && !q.push(p->right)) break;
             }
-
-            std::free(q);
             return cnt;
         }
     };
 
+    using BinaryTree = BasicBinaryTree<int>;
+
 } // namespace ds
 
 #endif // BINARYTREE_H
@@ -0,0 +1,158 @@
+//
+// Created by xiang on 26-10-17.
+//
+#ifndef CHUNKEDSTACK_H
+#define CHUNKEDSTACK_H
+
+#include <cstdlib>
+#include <cstddef>
+
+namespace ds {
+
+    // 分段栈：由固定大小的段首尾相连组成，接口与 Stack 相同
+    // - 满了只追加一段，从不整体搬移：push 最坏 O(1)，已入栈元素的地址在出栈前一直有效；
+    // - 出栈腾空的段先留作“空闲段”，超过 idleLimit 个才归还（留一段避免在段边界来回申请/释放）。
+    template <int SegmentInts = 1024>
+    class ChunkedStack {
+        static_assert(SegmentInts > 0, "SegmentInts must be positive");
+
+        struct Segment {
+            Segment *prev;
+            Segment *next;
+            int values[SegmentInts];
+        };
+
+        Segment *first;   // 栈底所在段
+        Segment *cur;     // 栈顶所在段（cur 之后的都是空闲段）
+        Segment *last;    // 段链表末尾
+        int used;         // cur 中已用的格子数
+        int curIndex;     // cur 是第几段
+        int top;          // 元素个数
+        int segments;     // 已申请的段数（含空闲段）
+        int idleLimit;    // 最多保留几个空闲段
+
+        Segment* newSegment() {
+            Segment* s = static_cast<Segment*>(std::malloc(sizeof(Segment)));
+            if (!s) return nullptr;
+            s->prev = last;
+            s->next = nullptr;
+            if (last) last->next = s; else first = s;
+            last = s;
+            ++segments;
+            return s;
+        }
+
+        // 从末尾归还空闲段，直到不超过 keep 个
+        void trimIdle(int keep) {
+            while (last && last != cur && segments - curIndex - 1 > keep) {
+                Segment* p = last->prev;
+                std::free(last);
+                --segments;
+                last = p;
+                if (last) last->next = nullptr; else first = nullptr;
+            }
+        }
+
+        // 定位第 i 个元素所在的段（调用方保证 0 <= i < top），从较近的一端走
+        Segment* segmentOf(int i) const {
+            const int k = i / SegmentInts;
+            Segment* s;
+            if (k <= curIndex - k) {
+                s = first;
+                for (int j = 0; j < k; ++j) s = s->next;
+            } else {
+                s = cur;
+                for (int j = curIndex; j > k; --j) s = s->prev;
+            }
+            return s;
+        }
+
+    public:
+        ChunkedStack() : first(nullptr), cur(nullptr), last(nullptr), used(0), curIndex(-1),
+                         top(0), segments(0), idleLimit(1) {}
+        ~ChunkedStack() {
+            Segment* p = first;
+            while (p) { Segment* q = p->next; std::free(p); p = q; }
+        }
+
+        // 持有裸段链表，禁止浅拷贝
+        ChunkedStack(const ChunkedStack&) = delete;
+        ChunkedStack& operator=(const ChunkedStack&) = delete;
+
+        // 入栈：当前段满时转入下一段（空闲段优先），失败返回 false
+        bool push(int value) {
+            if (!cur || used == SegmentInts) {
+                Segment* next = cur ? cur->next : first;
+                if (!next) next = newSegment();
+                if (!next) return false;
+                cur = next;
+                ++curIndex;
+                used = 0;
+            }
+            cur->values[used++] = value;
+            ++top;
+            return true;
+        }
+        // 出栈：当前段腾空就退回上一段，多余的空闲段按 idleLimit 归还
+        bool pop(int* out) {
+            if (top <= 0) return false;
+            --top;
+            --used;
+            if (out) *out = cur->values[used];
+            if (used == 0) {
+                cur = cur->prev;
+                --curIndex;
+                used = cur ? SegmentInts : 0;
+                trimIdle(idleLimit);
+            }
+            return true;
+        }
+        // 读栈顶
+        bool peek(int* out) const {
+            if (top <= 0) return false;
+            if (out) *out = cur->values[used - 1];
+            return true;
+        }
+        // 栈大小
+        int size() const { return top; }
+        // 是否为空
+        bool empty() const { return top == 0; }
+        // 清空栈：段留作空闲段，超出 idleLimit 的归还
+        void clear() {
+            cur = nullptr;
+            curIndex = -1;
+            used = 0;
+            top = 0;
+            trimIdle(idleLimit);
+        }
+        // 获取第 i 个元素（从底到顶），不合法返回 0
+        int get(int i) const {
+            if (i < 0 || i >= top) return 0;
+            return segmentOf(i)->values[i % SegmentInts];
+        }
+        // 获取栈顶元素，不存在返回 0
+        int getPeek() const { return top > 0 ? cur->values[used - 1] : 0; }
+
+        // 第 i 个元素的地址：在它出栈之前一直有效（后续 push 不会搬移它）
+        const int* addressOf(int i) const {
+            if (i < 0 || i >= top) return nullptr;
+            return &segmentOf(i)->values[i % SegmentInts];
+        }
+
+        // ========== 收缩策略 ==========
+        // 最多保留的空闲段数（默认 1；0 表示腾空即归还）
+        void setIdleLimit(int keep) {
+            idleLimit = keep < 0 ? 0 : keep;
+            trimIdle(idleLimit);
+        }
+        int idleSegments() const { return segments - curIndex - 1; }
+        // 立即归还全部空闲段
+        void shrink_to_fit() { trimIdle(0); }
+
+        int segmentCount() const { return segments; }
+        static constexpr int segmentCapacity() { return SegmentInts; }
+        std::size_t memoryBytes() const { return static_cast<std::size_t>(segments) * sizeof(Segment); }
+    };
+} // namespace ds
+
+#endif // CHUNKEDSTACK_H
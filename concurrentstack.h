@@ -0,0 +1,146 @@
+//
+// Created by xiang on 26-10-17.
+//
+#ifndef CONCURRENTSTACK_H
+#define CONCURRENTSTACK_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace ds {
+
+    // 无锁并发栈（Treiber 栈），接口与 Stack 的 push/pop/peek/size 相同，可被多个线程同时调用
+    // - 结点用 32 位下标表示，栈顶 = (版本号 << 32 | 下标) 打包进一个 64 位原子量，
+    //   每次成功的 CAS 都让版本号 +1，避免 ABA（普通 64 位 CAS 即可，不需要双字 CAS）；
+    // - 结点放在按块申请、只增不减的数组里，出栈的结点进入同样带版本号的无锁空闲表，
+    //   内存直到析构才释放，所以其它线程读到“已被弹出”的结点也不会访问野指针；
+    // - size() 与 peek() 在并发下只是某一时刻的快照。
+    class ConcurrentStack {
+        struct Node {
+            std::atomic<int> value;
+            std::atomic<std::uint32_t> next;
+        };
+
+        static constexpr std::uint32_t kNil = 0xFFFFFFFFu;
+        static constexpr int kChunkBits = 14;                 // 每块 16384 个结点
+        static constexpr std::uint32_t kChunkNodes = 1u << kChunkBits;
+        static constexpr std::uint32_t kMaxChunks = 1u << 14; // 最多约 2.7 亿个结点
+
+        std::atomic<std::uint64_t> head_;      // 栈顶（版本号 | 下标）
+        std::atomic<std::uint64_t> free_;      // 空闲结点表（版本号 | 下标）
+        std::atomic<std::uint32_t> fresh_;     // 下一个从未用过的下标
+        std::atomic<int> count_;
+        std::atomic<Node*>* chunks_;           // 块目录：下标高位选块，低位选块内结点
+
+        static std::uint32_t indexOf(std::uint64_t packed) { return static_cast<std::uint32_t>(packed); }
+        static std::uint64_t pack(std::uint32_t idx, std::uint64_t prev) {
+            return (((prev >> 32) + 1) << 32) | idx;  // 版本号在旧值基础上 +1
+        }
+
+        Node* node(std::uint32_t idx) const {
+            return chunks_[idx >> kChunkBits].load(std::memory_order_acquire) + (idx & (kChunkNodes - 1));
+        }
+
+        // 把 idx 压入 list（head_ 或 free_）
+        void pushIndex(std::atomic<std::uint64_t>& list, std::uint32_t idx) {
+            Node* n = node(idx);
+            std::uint64_t old = list.load(std::memory_order_relaxed);
+            do {
+                n->next.store(indexOf(old), std::memory_order_relaxed);
+            } while (!list.compare_exchange_weak(old, pack(idx, old),
+                                                 std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        // 从 list 弹出一个下标，空返回 kNil
+        std::uint32_t popIndex(std::atomic<std::uint64_t>& list) {
+            std::uint64_t old = list.load(std::memory_order_acquire);
+            for (;;) {
+                const std::uint32_t idx = indexOf(old);
+                if (idx == kNil) return kNil;
+                // 该结点可能刚被别的线程弹出并复用，读到的 next 是旧值也没关系：版本号已变，CAS 会失败重来
+                const std::uint32_t next = node(idx)->next.load(std::memory_order_relaxed);
+                if (list.compare_exchange_weak(old, pack(next, old),
+                                               std::memory_order_acquire, std::memory_order_acquire)) {
+                    return idx;
+                }
+            }
+        }
+
+        // 申请一个结点：优先复用空闲表，否则取一个新下标（所在块不存在时申请，抢输的一方释放自己那块）
+        std::uint32_t allocIndex() {
+            std::uint32_t idx = popIndex(free_);
+            if (idx != kNil) return idx;
+
+            idx = fresh_.fetch_add(1, std::memory_order_relaxed);
+            if (idx >= kChunkNodes * kMaxChunks) return kNil;
+            std::atomic<Node*>& slot = chunks_[idx >> kChunkBits];
+            if (!slot.load(std::memory_order_acquire)) {
+                Node* c = static_cast<Node*>(std::malloc(sizeof(Node) * kChunkNodes));
+                if (!c) return kNil;
+                for (std::uint32_t i = 0; i < kChunkNodes; ++i) ::new (static_cast<void*>(c + i)) Node{};
+                Node* expected = nullptr;
+                if (!slot.compare_exchange_strong(expected, c, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    std::free(c);
+                }
+            }
+            return idx;
+        }
+
+    public:
+        ConcurrentStack() : head_(kNil), free_(kNil), fresh_(0), count_(0), chunks_(nullptr) {
+            chunks_ = static_cast<std::atomic<Node*>*>(std::malloc(sizeof(std::atomic<Node*>) * kMaxChunks));
+            if (chunks_) {
+                for (std::uint32_t i = 0; i < kMaxChunks; ++i) ::new (static_cast<void*>(chunks_ + i)) std::atomic<Node*>(nullptr);
+            }
+        }
+
+        // 析构时不得再有其它线程在使用
+        ~ConcurrentStack() {
+            if (!chunks_) return;
+            for (std::uint32_t i = 0; i < kMaxChunks; ++i) {
+                Node* c = chunks_[i].load(std::memory_order_relaxed);
+                if (c) std::free(c);
+            }
+            std::free(chunks_);
+        }
+
+        ConcurrentStack(const ConcurrentStack&) = delete;
+        ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+        // 入栈，结点申请失败返回 false
+        bool push(int value) {
+            if (!chunks_) return false;
+            const std::uint32_t idx = allocIndex();
+            if (idx == kNil) return false;
+            node(idx)->value.store(value, std::memory_order_relaxed);
+            pushIndex(head_, idx);
+            count_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        // 出栈，空栈返回 false
+        bool pop(int* out) {
+            if (!chunks_) return false;
+            const std::uint32_t idx = popIndex(head_);
+            if (idx == kNil) return false;
+            if (out) *out = node(idx)->value.load(std::memory_order_relaxed);
+            count_.fetch_sub(1, std::memory_order_relaxed);
+            pushIndex(free_, idx);
+            return true;
+        }
+        // 读栈顶（并发下为快照）
+        bool peek(int* out) const {
+            const std::uint32_t idx = indexOf(head_.load(std::memory_order_acquire));
+            if (idx == kNil) return false;
+            if (out) *out = node(idx)->value.load(std::memory_order_relaxed);
+            return true;
+        }
+        // 栈大小（并发下为快照）
+        int size() const { return count_.load(std::memory_order_relaxed); }
+        // 是否为空
+        bool empty() const { return indexOf(head_.load(std::memory_order_acquire)) == kNil; }
+    };
+} // namespace ds
+
+#endif // CONCURRENTSTACK_H
@@ -0,0 +1,193 @@
+//
+// Created by xiang on 26-10-17.
+//
+#ifndef DLINKLIST_H
+#define DLINKLIST_H
+
+#include <cstddef>
+#include <iterator>
+#include "nodepool.h"
+
+namespace ds {
+
+    struct DLNode {
+        int value;
+        DLNode *prev;
+        DLNode *next;
+    };
+
+    // 双链表：每个结点多一个 prev 指针
+    // - 两端插入/删除都是 O(1)（删尾不必再从头找前驱）；
+    // - 按下标访问从离得近的一端开始走，最坏 n/2 步。
+    class DLinklist {
+        DLNode *head;
+        DLNode *tail;
+        int length;
+        NodePool<DLNode> pool;  // 与 Linklist 相同的结点池
+
+        // 定位到 position 位置的结点（调用方保证 0 <= position < length）
+        DLNode* nodeAt(int position) const {
+            if (position < length - position) {
+                DLNode* p = head;
+                for (int i = 0; i < position; ++i) p = p->next;
+                return p;
+            }
+            DLNode* p = tail;
+            for (int i = length - 1; i > position; --i) p = p->prev;
+            return p;
+        }
+
+        // 新建一个节点
+        DLNode* build(int v) {
+            DLNode* p = pool.alloc();
+            if (!p) return nullptr;
+            p->value = v;
+            p->prev  = nullptr;
+            p->next  = nullptr;
+            return p;
+        }
+
+        // 摘下结点 p 并归还结点池
+        void unlink(DLNode* p) {
+            if (p->prev) p->prev->next = p->next; else head = p->next;
+            if (p->next) p->next->prev = p->prev; else tail = p->prev;
+            pool.release(p);
+            --length;
+        }
+
+    public:
+        DLinklist() : head(nullptr), tail(nullptr), length(0) {}
+
+        ~DLinklist() {
+            clear();
+        }
+
+        // 结点归结点池所有，禁止浅拷贝
+        DLinklist(const DLinklist&) = delete;
+        DLinklist& operator=(const DLinklist&) = delete;
+
+        // 长度
+        int size() const {
+            return length;
+        }
+
+        // 只读头/尾指针
+        DLNode* gethead() const {
+            return head;
+        }
+
+        DLNode* gettail() const {
+            return tail;
+        }
+
+        // 只读双向迭代器
+        class const_iterator {
+            const DLNode* p;
+            const DLNode* last;  // 用于从 end() 往回走
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type        = int;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = const int*;
+            using reference         = const int&;
+
+            const_iterator() : p(nullptr), last(nullptr) {}
+            const_iterator(const DLNode* node, const DLNode* tailNode) : p(node), last(tailNode) {}
+
+            reference operator*() const { return p->value; }
+            pointer operator->() const { return &p->value; }
+            const_iterator& operator++() { p = p->next; return *this; }
+            const_iterator operator++(int) { const_iterator t = *this; p = p->next; return t; }
+            const_iterator& operator--() { p = p ? p->prev : last; return *this; }
+            const_iterator operator--(int) { const_iterator t = *this; --*this; return t; }
+            bool operator==(const const_iterator& o) const { return p == o.p; }
+            bool operator!=(const const_iterator& o) const { return p != o.p; }
+
+            // 当前结点（画图时需要结点指针）
+            const DLNode* node() const { return p; }
+        };
+
+        const_iterator begin() const { return const_iterator(head, tail); }
+        const_iterator end() const { return const_iterator(nullptr, tail); }
+
+        // 清空链表：结点池整体回收，不逐个释放
+        void clear() {
+            pool.reset();
+            head = tail = nullptr;
+            length = 0;
+        }
+
+        // 头插
+        void push_front(int value) {
+            DLNode* p = build(value);
+            if (!p) return;
+            p->next = head;
+            if (head) head->prev = p; else tail = p;
+            head = p;
+            ++length;
+        }
+
+        // 尾插
+        void push_back(int value) {
+            DLNode* p = build(value);
+            if (!p) return;
+            p->prev = tail;
+            if (tail) tail->next = p; else head = p;
+            tail = p;
+            ++length;
+        }
+
+        // 头删，空表返回 false
+        bool pop_front() {
+            if (!head) return false;
+            unlink(head);
+            return true;
+        }
+
+        // 尾删，空表返回 false
+        bool pop_back() {
+            if (!tail) return false;
+            unlink(tail);
+            return true;
+        }
+
+        // 在 position 位置插入（0 <= position <= length）
+        // position <= 0 视为头插；position >= length 视为尾插
+        bool insert(int position, int value) {
+            if (position <= 0) {
+                push_front(value);
+                return true;
+            }
+            if (position >= length) {
+                push_back(value);
+                return true;
+            }
+
+            DLNode* succ = nodeAt(position);
+            DLNode* p = build(value);
+            if (!p) return false;
+
+            p->prev = succ->prev;
+            p->next = succ;
+            succ->prev->next = p;
+            succ->prev = p;
+            ++length;
+            return true;
+        }
+
+        // 删除 position 位置结点（0..length-1），两端 O(1)
+        bool erase(int position) {
+            if (position < 0 || position >= length) return false;
+            unlink(nodeAt(position));
+            return true;
+        }
+
+        // 获取 position 位置的值，不合法返回 0
+        int get(int position) const {
+            if (position < 0 || position >= length) return 0;
+            return nodeAt(position)->value;
+        }
+    };
+} // namespace ds
+
+#endif // DLINKLIST_H
@@ -33,9 +33,10 @@ bool validateDslScript(const QString& all, QString* errorTitle, QString* errorDi
             if (!mm.hasMatch()) continue;
             const QString head = mm.captured(1);
 
-            if (head == "seq"  || head == "link" || head == "stack" ||
+            if (head == "seq"  || head == "link" || head == "dlink" || head == "stack" ||
                 head == "bt"   || head == "bst"  || head == "huff"  || head == "avl") {
-                families.insert(head);
+                // dlink 是链表页的双链表存储模式（link.mode doubly），与 link 算同一种结构
+                families.insert(head == "dlink" ? QStringLiteral("link") : head);
             }
         }
 
@@ -58,13 +59,16 @@ bool validateDslScript(const QString& all, QString* errorTitle, QString* errorDi
 
     // =============== 单行多指令校验（不允许一行包含两条或以上指令） ===============
     static const QRegularExpression kCmdTokenRe(
-        R"((?<![a-z])(seq|link|stack|bt|bst|huff|avl)(?:\.[a-z]+)?(?![a-z]))",
+        R"((?<![a-z])(seq|link|dlink|stack|bt|bst|huff|avl)(?:\.[a-z]+)?(?![a-z]))",
         QRegularExpression::CaseInsensitiveOption
     );
 
     for (const QString& rawLine : lines) {
-        const QString s = rawLine.trimmed();
+        QString s = rawLine.trimmed();
         if (s.isEmpty()) continue;
+        // huff.encode 后面是文件路径，路径里的字符不参与校验
+        if (s.startsWith(QStringLiteral("huff.encode"), Qt::CaseInsensitive))
+            s = s.left(QStringLiteral("huff.encode").size());
 
         const bool hasBadSep = s.contains(';') || s.contains(u'；')
                              || s.contains("&&") || s.contains("||")
@@ -121,11 +125,14 @@ QStringList nliToDsl(const QString& low, const std::function<QVector<int>(const
     };
     hitIf("seq",  {"顺序表","顺序","数组","seqlist","seq"});
     hitIf("link", {"链表","链","linklist","link"});
+    hitIf("dlink",{"双链表","双向链表","dlinklist","dlink"});
     hitIf("stack",{"栈","stack"});
     hitIf("bt",   {"二叉树","普通二叉树","binary tree","bt"});
     hitIf("bst",  {"二叉搜索树","binary search tree","bst"});
     hitIf("huff", {"哈夫曼","huffman","huff"});
     hitIf("avl",  {"平衡二叉树","avl"});
+    // “双链表”里也含“链表”，命中双链表时不再算作单链表
+    if (hits.contains("dlink")) hits.remove("link");
 
     if (hits.size() > 1) {
         QStringList fam;
@@ -146,7 +153,7 @@ QStringList nliToDsl(const QString& low, const std::function<QVector<int>(const
             *errorTitle = QStringLiteral("未识别");
         if (errorDialogText) {
             *errorDialogText =
-                QStringLiteral("NLI：未能识别数据结构类型，请补充如“顺序表/链表/栈/二叉树/BST/哈夫曼/AVL”等关键词。");
+                QStringLiteral("NLI：未能识别数据结构类型，请补充如“顺序表/链表/双链表/栈/二叉树/BST/哈夫曼/AVL”等关键词。");
         }
         return dslLines;
     }
@@ -215,6 +222,21 @@ QStringList nliToDsl(const QString& low, const std::function<QVector<int>(const
             } else if (hasAny({"删除","删","移除","erase","remove"})) {
                 if (nums.size() >= 1)
                     dsl = QString("seq.erase %1").arg(nums[0]);
+            } else if (hasAny({"最小","min"})) {
+                dsl = "seq.min";
+            } else if (hasAny({"最大","max"})) {
+                dsl = "seq.max";
+            } else if (hasAny({"求和","总和","sum"})) {
+                dsl = "seq.sum";
+            } else if (hasAny({"个数","次数","count"})) {
+                if (nums.size() >= 1)
+                    dsl = QString("seq.count %1").arg(nums[0]);
+            } else if (hasAny({"大于","greater"})) {
+                if (nums.size() >= 1)
+                    dsl = QString("seq.gt %1").arg(nums[0]);
+            } else if (hasAny({"查找","寻找","搜索","find","search"})) {
+                if (nums.size() >= 1)
+                    dsl = QString("seq.find %1").arg(nums[0]);
             } else if (!nums.isEmpty()) {
                 dsl = "seq " + joinNums(nums);
             }
@@ -222,6 +244,10 @@ QStringList nliToDsl(const QString& low, const std::function<QVector<int>(const
         else if (kind == "link") {
             if (hasAny({"清空","清除","clear"})) {
                 dsl = "link.clear";
+            } else if (hasAny({"块状","分块","unrolled"})) {
+                dsl = "link.mode unrolled";
+            } else if (hasAny({"普通单链表","单结点","node mode"})) {
+                dsl = "link.mode node";
             } else if (hasAny({"插入","插","增","insert"})) {
                 if (nums.size() >= 2)
                     dsl = QString("link.insert %1 %2").arg(nums[0]).arg(nums[1]);
@@ -232,6 +258,26 @@ QStringList nliToDsl(const QString& low, const std::function<QVector<int>(const
                 dsl = "link " + joinNums(nums);
             }
         }
+        else if (kind == "dlink") {
+            if (hasAny({"清空","清除","clear"})) {
+                dsl = "dlink.clear";
+            } else if (hasAny({"头删","删除头","删头","popfront"})) {
+                dsl = "dlink.popfront";
+            } else if (hasAny({"尾删","删除尾","删尾","popback"})) {
+                dsl = "dlink.popback";
+            } else if (hasAny({"插入","插","增","insert"})) {
+                if (nums.size() >= 2)
+                    dsl = QString("dlink.insert %1 %2").arg(nums[0]).arg(nums[1]);
+            } else if (hasAny({"删除","删","移除","erase","remove"})) {
+                if (nums.size() >= 1)
+                    dsl = QString("dlink.erase %1").arg(nums[0]);
+            } else if (hasAny({"访问","获取","取第","get"})) {
+                if (nums.size() >= 1)
+                    dsl = QString("dlink.get %1").arg(nums[0]);
+            } else if (!nums.isEmpty()) {
+                dsl = "dlink " + joinNums(nums);
+            }
+        }
         else if (kind == "stack") {
             if (hasAny({"清空","清除","clear"})) {
                 dsl = "stack.clear";
@@ -263,6 +309,11 @@ QStringList nliToDsl(const QString& low, const std::function<QVector<int>(const
         else if (kind == "bst") {
             if (hasAny({"清空","清除","clear"})) {
                 dsl = "bst.clear";
+            } else if (hasAny({"平衡","balance"})) {
+                dsl = "bst.balance";
+            } else if (hasAny({"第k小","第 k 小","kth","k-th"})) {
+                if (nums.size() >= 1)
+                    dsl = QString("bst.kth %1").arg(nums[0]);
             } else if (hasAny({"查找","寻找","搜索","find","search"})) {
                 if (nums.size() >= 1)
                     dsl = QString("bst.find %1").arg(nums[0]);
@@ -279,6 +330,10 @@ QStringList nliToDsl(const QString& low, const std::function<QVector<int>(const
         else if (kind == "huff") {
             if (hasAny({"清空","清除","clear"})) {
                 dsl = "huff.clear";
+            } else if (hasAny({"限长","最大码长","limit"})) {
+                // 第一个数是最大码长，其余是权值
+                if (nums.size() >= 1)
+                    dsl = "huff.limit " + joinNums(nums);
             } else if (!nums.isEmpty()) {
                 dsl = "huff " + joinNums(nums);
             }
@@ -289,6 +344,12 @@ QStringList nliToDsl(const QString& low, const std::function<QVector<int>(const
             } else if (hasAny({"插入","插","加入","添加","insert","add"})) {
                 if (nums.size() >= 1)
                     dsl = QString("avl.insert %1").arg(nums[0]);
+            } else if (hasAny({"删除","删","移除","erase","remove"})) {
+                if (nums.size() >= 1)
+                    dsl = QString("avl.erase %1").arg(nums[0]);
+            } else if (hasAny({"排名","名次","rank"})) {
+                if (nums.size() >= 1)
+                    dsl = QString("avl.rank %1").arg(nums[0]);
             } else if (!nums.isEmpty()) {
                 dsl = "avl " + joinNums(nums);
             }
@@ -0,0 +1,180 @@
+//
+// Created by xiang on 26-10-17.
+//
+
+#ifndef EYTZINGER_H
+#define EYTZINGER_H
+
+#include "binarytree.h"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace ds {
+
+    // 搜索树的只读快照：键按 Eytzinger（BFS / 堆）顺序存进一段连续数组，a[1] 为根，a[k] 的孩子是 a[2k]、a[2k+1]。
+    // - 查找不再追 BTNode 指针：每层一次比较，k = 2k + (a[k] < key)，没有难预测的分支；
+    // - 数组按 64 字节对齐，a[16k..16k+15] 正好是 k 往下第 4 层的全部后代，占一条缓存行，下降时提前一行预取；
+    // - 批量查找把一组查询按层交错推进，各自的访存可以同时在路上。
+    // 快照与原树不再有关联：树之后的修改不会反映到快照里，需要时重新 toEytzinger()。
+    class EytzingerSnapshot {
+    public:
+        static constexpr int kLineInts = 64 / static_cast<int>(sizeof(int));  // 一条缓存行放的键数
+        static constexpr int kBatch = 16;                                     // 批量查找时同时推进的查询数
+
+        EytzingerSnapshot() = default;
+        ~EytzingerSnapshot() { std::free(raw_); }
+        EytzingerSnapshot(const EytzingerSnapshot&) = delete;
+        EytzingerSnapshot& operator=(const EytzingerSnapshot&) = delete;
+
+        // 用严格递增的数组 sorted[0..n) 建快照（替换原有内容），O(n)；申请内存失败返回 false，快照为空
+        bool assign(const int* sorted, int n) {
+            if (!reserve(n)) return false;
+            int i = 0;
+            fill([&]() { return sorted[i++]; });
+            return true;
+        }
+
+        // 用搜索树建快照：中序迭代一遍，n 为树的结点数，O(n)
+        bool assign(const BTNode* root, int n) {
+            if (!reserve(n)) return false;
+            BinaryTree::InorderIterator it = BinaryTree::InorderIterator::first(root);
+            fill([&]() {
+                const int k = *it;
+                ++it;
+                return k;
+            });
+            return true;
+        }
+
+        void clear() {
+            std::free(raw_);
+            raw_ = nullptr;
+            a_ = nullptr;
+            n_ = 0;
+            levels_ = 0;
+        }
+
+        int size() const { return static_cast<int>(n_); }
+        bool empty() const { return n_ == 0; }
+
+        // 第一个 >= key 的键，没有返回 nullptr
+        // 下降到越过叶子为止，k 的二进制从高到低就是一路的左右选择；最后一次“向右”之前的那个结点就是答案：
+        // 去掉末尾连续的 1（向右的那几步）再去掉一个 0，O(log n)
+        const int* lower_bound(int key) const {
+            std::size_t k = 1;
+            while (k <= n_) {
+                prefetchLine(k);
+                k = 2 * k + (a_[k] < key);
+            }
+            k >>= std::countr_one(k) + 1;
+            return k ? a_ + k : nullptr;
+        }
+
+        // 查找 key，不存在返回 nullptr
+        const int* find(int key) const {
+            const int* p = lower_bound(key);
+            return p && *p == key ? p : nullptr;
+        }
+        bool contains(int key) const { return find(key) != nullptr; }
+
+        // 批量 lower_bound：out[i] 为第一个 >= q[i] 的键（没有为 nullptr）
+        // 每 kBatch 个查询一组，按层交错推进；前 levels_-1 层是满的，不用判断越界，最后一层（可能不满）用条件传送
+        void lowerBoundBatch(const int* q, int m, const int** out) const {
+            if (!q || !out || m <= 0) return;
+            if (!n_) {
+                for (int i = 0; i < m; ++i) out[i] = nullptr;
+                return;
+            }
+            for (int base = 0; base < m; base += kBatch) {
+                const int g = (m - base < kBatch) ? m - base : kBatch;
+                const int* qs = q + base;
+                std::size_t k[kBatch];
+                for (int j = 0; j < g; ++j) k[j] = 1;
+                for (int d = 1; d < levels_; ++d) {
+                    for (int j = 0; j < g; ++j) {
+                        prefetchLine(k[j]);
+                        k[j] = 2 * k[j] + (a_[k[j]] < qs[j]);
+                    }
+                }
+                for (int j = 0; j < g; ++j) {
+                    std::size_t x = k[j];
+                    const bool in = x <= n_;
+                    const std::size_t idx = in ? x : 0;  // a_[0] 是占位，越界时读它，结果不用
+                    const std::size_t nx = 2 * x + (a_[idx] < qs[j]);
+                    x = in ? nx : x;
+                    x >>= std::countr_one(x) + 1;
+                    out[base + j] = x ? a_ + x : nullptr;
+                }
+            }
+        }
+
+        // 批量查找：hits[i] 为 q[i] 是否在快照中（hits 可为 nullptr），返回命中个数
+        int findBatch(const int* q, int m, bool* hits) const {
+            if (!q || m <= 0) return 0;
+            const int* found[kBatch];
+            int cnt = 0;
+            for (int base = 0; base < m; base += kBatch) {
+                const int g = (m - base < kBatch) ? m - base : kBatch;
+                lowerBoundBatch(q + base, g, found);
+                for (int j = 0; j < g; ++j) {
+                    const bool hit = found[j] && *found[j] == q[base + j];
+                    if (hits) hits[base + j] = hit;
+                    cnt += hit;
+                }
+            }
+            return cnt;
+        }
+
+    private:
+        void* raw_ = nullptr;    // malloc 得到的原始地址
+        int* a_ = nullptr;       // 对齐后的数组，a_[0] 不用，键在 a_[1..n_]
+        std::size_t n_ = 0;
+        int levels_ = 0;         // 树的层数 = bit_width(n)
+
+        bool reserve(int n) {
+            clear();
+            if (n <= 0) return true;
+            // 多申请一条缓存行用来把 a_ 对齐到 64 字节
+            raw_ = std::malloc(sizeof(int) * (static_cast<std::size_t>(n) + 1) + 64);
+            if (!raw_) return false;
+            const std::uintptr_t p = reinterpret_cast<std::uintptr_t>(raw_);
+            a_ = reinterpret_cast<int*>((p + 63) / 64 * 64);
+            a_[0] = 0;
+            n_ = static_cast<std::size_t>(n);
+            levels_ = static_cast<int>(std::bit_width(n_));
+            return true;
+        }
+
+        // 按中序依次给出 n_ 个位置（先是最左下的结点，之后是中序后继），next() 依次给出从小到大的键
+        template <typename Next>
+        void fill(Next next) {
+            if (!n_) return;
+            std::size_t k = 1;
+            while (2 * k <= n_) k *= 2;
+            for (std::size_t i = 0; i < n_; ++i) {
+                a_[k] = next();
+                if (2 * k + 1 <= n_) {
+                    k = 2 * k + 1;                 // 有右子树：走到右子树的最左
+                    while (2 * k <= n_) k *= 2;
+                } else {
+                    k >>= std::countr_one(k) + 1;  // 否则往上退过所有“自己是右孩子”的层，再退一层
+                }
+            }
+        }
+
+        // 预取 k 往下第 4 层的后代所在的缓存行；只是提示，地址越过数组末尾也不会出错，按整数算地址不形成越界指针
+        void prefetchLine(std::size_t k) const {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(reinterpret_cast<const void*>(
+                    reinterpret_cast<std::uintptr_t>(a_) + k * kLineInts * sizeof(int)));
+#else
+            (void)k;
+#endif
+        }
+    };
+
+} // namespace ds
+
+#endif // EYTZINGER_H
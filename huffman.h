@@ -4,84 +4,299 @@
 #ifndef HUFFMAN_H
 #define HUFFMAN_H
 #include "binarytree.h"
+#include <algorithm>
 #include <cstdlib>
 namespace ds {
     class Huffman : public BinaryTree {
+    public:
+        // 选最小两棵的方式
+        enum class BuildMode {
+            Auto,     // 权值已按非降序排好时走双队列，否则走堆
+            Heap,     // 二叉小根堆：每次合并 O(log n)，整体 O(n log n)
+            TwoQueue  // 双队列：要求权值非降序（否则退回堆），整体 O(n)
+        };
+
+    private:
+        // 堆/队列里的一项：同权值时按 id 先后（原始叶子 0..n-1，合并出的结点依次 n, n+1, ...）
+        // 这样堆和双队列在权值相同时选中的结点完全一致，两种方式建出的树相同
+        struct Item {
+            int weight;
+            int id;
+            BTNode* node;
+        };
+
+        static bool less(const Item& a, const Item& b) {
+            return a.weight != b.weight ? a.weight < b.weight : a.id < b.id;
+        }
+
+        static void siftDown(Item* h, int n, int i) {
+            const Item x = h[i];
+            for (;;) {
+                int c = 2 * i + 1;
+                if (c >= n) break;
+                if (c + 1 < n && less(h[c + 1], h[c])) ++c;
+                if (!less(h[c], x)) break;
+                h[i] = h[c];
+                i = c;
+            }
+            h[i] = x;
+        }
+
+        static void siftUp(Item* h, int i) {
+            const Item x = h[i];
+            while (i > 0) {
+                const int p = (i - 1) / 2;
+                if (!less(x, h[p])) break;
+                h[i] = h[p];
+                i = p;
+            }
+            h[i] = x;
+        }
+
+        static Item popMin(Item* h, int& n) {
+            const Item top = h[0];
+            h[0] = h[--n];
+            if (n > 0) siftDown(h, n, 0);
+            return top;
+        }
+
     public:
         Huffman() : BinaryTree() {}
         ~Huffman() override = default;
+
+        // 由权值建 Huffman 树，返回根（n<=0 或申请内存失败返回 nullptr）
+        // - leaves 不为空时写入 n 个叶子结点，顺序与 weights 相同（界面画初始森林用）；
+        // - 每次合并后调用 onMerge(left, right, parent)：left 为较小的一棵，界面用它按顺序播放合并过程；
+        // - 2n-1 个结点先一次从本树的结点池里取好，合并过程中不会再失败；
+        // - 只分配结点，不改 rootNode：调用方先 clear()，建好后再把返回的根挂上去。
+        template <typename OnMerge>
+        BTNode* buildTree(const int* weights, int n, BTNode** leaves, OnMerge onMerge,
+                                 BuildMode mode = BuildMode::Auto) {
+            if (!weights || n <= 0) return nullptr;
+
+            const int total = 2 * n - 1;
+            BTNode** nodes = static_cast<BTNode**>(std::malloc(sizeof(BTNode*) * static_cast<std::size_t>(total)));
+            Item* items = static_cast<Item*>(std::malloc(sizeof(Item) * static_cast<std::size_t>(total)));
+            if (!nodes || !items) {
+                std::free(nodes);
+                std::free(items);
+                return nullptr;
+            }
+            for (int i = 0; i < total; ++i) {
+                nodes[i] = buildNode(i < n ? weights[i] : 0);
+                if (!nodes[i]) {
+                    for (int k = 0; k < i; ++k) freeNode(nodes[k]);
+                    std::free(nodes);
+                    std::free(items);
+                    return nullptr;
+                }
+            }
+
+            if (leaves) {
+                for (int i = 0; i < n; ++i) leaves[i] = nodes[i];
+            }
+
+            bool sorted = (mode != BuildMode::Heap);
+            for (int i = 1; i < n && sorted; ++i) sorted = weights[i - 1] <= weights[i];
+
+            auto merge = [&](const Item& a, const Item& b, int id) {
+                BTNode* p = nodes[id];
+                p->key = a.weight + b.weight;
+                p->left = a.node;
+                p->right = b.node;
+                onMerge(a.node, b.node, p);
+                return Item{p->key, id, p};
+            };
+
+            if (sorted) {
+                // 双队列：叶子队列已有序；合并出的权值单调不减，按产生顺序排成第二个队列
+                // 每次从两个队头里取较小的，不需要堆
+                for (int i = 0; i < n; ++i) items[i] = Item{weights[i], i, nodes[i]};
+                int lh = 0;          // 叶子队列头（items[0..n)）
+                int mh = n, mt = n;  // 合并队列 items[mh..mt)
+                auto take = [&]() {
+                    if (mh == mt || (lh < n && less(items[lh], items[mh]))) return items[lh++];
+                    return items[mh++];
+                };
+                for (int id = n; id < total; ++id) {
+                    const Item a = take();
+                    const Item b = take();
+                    items[mt++] = merge(a, b, id);
+                }
+            } else {
+                int hn = 0;
+                for (int i = 0; i < n; ++i) items[hn++] = Item{weights[i], i, nodes[i]};
+                for (int i = hn / 2 - 1; i >= 0; --i) siftDown(items, hn, i);  // O(n) 建堆
+                for (int id = n; id < total; ++id) {
+                    const Item a = popMin(items, hn);
+                    const Item b = popMin(items, hn);
+                    items[hn] = merge(a, b, id);
+                    siftUp(items, hn++);
+                }
+            }
+
+            BTNode* root = nodes[total - 1];
+            std::free(nodes);
+            std::free(items);
+            return root;
+        }
+
         // 根据权值数组构建 Huffman 树
-        void buildFromWeights(const int* weights, int n) {
+        void buildFromWeights(const int* weights, int n, BuildMode mode = BuildMode::Auto) {
             clear();
-            if (!weights || n <= 0) {
-                rootNode = nullptr;
-                return;
+            rootNode = buildTree(weights, n, nullptr, [](BTNode*, BTNode*, BTNode*) {}, mode);
+        }
+
+        // 各权值的码长（叶子深度），n == 1 时记 1；申请内存失败返回 false
+        static bool codeLengths(const int* weights, int n, int* lens, BuildMode mode = BuildMode::Auto) {
+            if (!weights || !lens || n <= 0) return false;
+            if (n == 1) {
+                lens[0] = 1;
+                return true;
+            }
+            BTNode** leaves = static_cast<BTNode**>(std::malloc(sizeof(BTNode*) * static_cast<std::size_t>(n)));
+            if (!leaves) return false;
+            Huffman tmp;  // 析构时整池释放
+            BTNode* root = tmp.buildTree(weights, n, leaves, [](BTNode*, BTNode*, BTNode*) {}, mode);
+            if (!root) {
+                std::free(leaves);
+                return false;
+            }
+            // 借 height 字段记深度（哈夫曼树不维护增广信息）
+            root->height = 0;
+            preorderWalk(root, [](BTNode* p) {
+                if (p->left) p->left->height = p->height + 1;
+                if (p->right) p->right->height = p->height + 1;
+            });
+            for (int i = 0; i < n; ++i) lens[i] = leaves[i]->height;
+            std::free(leaves);
+            return true;
+        }
+
+        // 限长码长（package-merge）：在所有码长不超过 maxLen 的前缀码里带权路径长度最小的一个
+        // 权值按 (权值, 下标) 升序排成一列；从最深层开始，把上一层相邻两项打包，与叶子列归并，共 maxLen-1 轮；
+        // 最后一层取前 2n-2 项，每个叶子的码长就是它在被选中的项里（含包里）出现的次数。
+        // 需要 2^maxLen >= n，否则放不下，返回 false；时间、空间 O(n·maxLen)
+        static bool limitedCodeLengths(const int* weights, int n, int maxLen, int* lens) {
+            if (!weights || !lens || n <= 0 || maxLen < 1) return false;
+            if (n == 1) {
+                lens[0] = 1;
+                return true;
             }
+            if (maxLen < 31 && (1 << maxLen) < n) return false;
+            if (maxLen > n - 1) maxLen = n - 1;  // 任何最优树都不会比 n-1 更深
 
-            // 初始森林：每个权值一棵单结点树
-            BTNode** forest = static_cast<BTNode**>( std::malloc(sizeof(BTNode*) * static_cast<std::size_t>(n)));
-            if (!forest) {
-                rootNode = nullptr;
-                return;
+            const std::size_t cap = 2 * static_cast<std::size_t>(n);
+            int* order = static_cast<int*>(std::malloc(sizeof(int) * static_cast<std::size_t>(n)));
+            long long* cur = static_cast<long long*>(std::malloc(sizeof(long long) * cap));
+            long long* next = static_cast<long long*>(std::malloc(sizeof(long long) * cap));
+            // leafFlag[l * cap + i]：第 l 层（0 为最深层）归并后的第 i 项是否是叶子
+            char* leafFlag = static_cast<char*>(std::malloc(cap * static_cast<std::size_t>(maxLen)));
+            if (!order || !cur || !next || !leafFlag) {
+                std::free(order);
+                std::free(cur);
+                std::free(next);
+                std::free(leafFlag);
+                return false;
             }
 
+            for (int i = 0; i < n; ++i) order[i] = i;
+            std::sort(order, order + n, [weights](int a, int b) {
+                return weights[a] != weights[b] ? weights[a] < weights[b] : a < b;
+            });
+
+            int m = n;  // 当前层的项数
             for (int i = 0; i < n; ++i) {
-                forest[i] = buildNode(weights[i]);
-                if (!forest[i]) {
-                    // 分配失败，简单清理已经建好的若干棵，递归释放每棵树
-                    for (int k = 0; k < i; ++k) {
-                        BTNode* r = forest[k];
-                        // 直接调用 BinaryTree::clear() 无法逐棵清理，这里简化：泄露这些少量内存风险可以接受（课设场景）。
-                        (void)r;
+                cur[i] = weights[order[i]];
+                leafFlag[i] = 1;
+            }
+            for (int l = 1; l < maxLen; ++l) {
+                // 上一层相邻两项打包，与叶子归并（同权值时叶子在前）
+                const int packs = m / 2;
+                char* flag = leafFlag + static_cast<std::size_t>(l) * cap;
+                int i = 0, k = 0, out = 0;
+                while (i < n || k < packs) {
+                    const long long pw = k < packs ? cur[2 * k] + cur[2 * k + 1] : 0;
+                    if (k >= packs || (i < n && weights[order[i]] <= pw)) {
+                        next[out] = weights[order[i++]];
+                        flag[out++] = 1;
+                    } else {
+                        next[out] = pw;
+                        flag[out++] = 0;
+                        ++k;
                     }
-                    std::free(forest);
-                    rootNode = nullptr;
-                    return;
                 }
+                long long* t = cur;
+                cur = next;
+                next = t;
+                m = out;
             }
 
-            int m = n;
-            while (m > 1) {
-                // 找出两棵权值最小的树 i1, i2
-                int i1 = -1, i2 = -1;
-                for (int i = 0; i < m; ++i) {
-                    if (i1 == -1 || forest[i]->key < forest[i1]->key) {
-                        i1 = i;
-                    }
-                }
-                for (int i = 0; i < m; ++i) {
-                    if (i == i1) continue;
-                    if (i2 == -1 || forest[i]->key < forest[i2]->key) {
-                        i2 = i;
-                    }
-                }
-                if (i1 > i2) {
-                    int t = i1;
-                    i1 = i2;
-                    i2 = t;
-                }
+            // 从最上层往下展开：取前 take 项，其中的叶子各加一层，包展开成下一层的 2 项
+            for (int i = 0; i < n; ++i) lens[i] = 0;
+            int take = 2 * n - 2;
+            for (int l = maxLen - 1; l >= 0 && take > 0; --l) {
+                const char* flag = leafFlag + static_cast<std::size_t>(l) * cap;
+                int leavesTaken = 0;
+                for (int i = 0; i < take; ++i) leavesTaken += flag[i];
+                for (int i = 0; i < leavesTaken; ++i) ++lens[order[i]];
+                take = 2 * (take - leavesTaken);
+            }
 
-                BTNode* p = buildNode(forest[i1]->key + forest[i2]->key);
-                if (!p) {
-                    // 分配失败同样简单处理
-                    std::free(forest);
-                    rootNode = nullptr;
-                    return;
-                }
-                p->left  = forest[i1];
-                p->right = forest[i2];
+            std::free(order);
+            std::free(cur);
+            std::free(next);
+            std::free(leafFlag);
+            return true;
+        }
 
-                forest[i1] = p;
-                forest[i2] = forest[m - 1];
-                --m;
+        // 由码长建范式码的树：码字按 (码长, 下标) 依次递增分配，叶子 key 为权值，内部结点 key 为子树权值和
+        // leaves 不为空时写入各权值对应的叶子；码长不满足前缀码条件或申请内存失败返回 nullptr
+        // 结点取自本树的结点池，同 buildTree 不改 rootNode
+        BTNode* canonicalTree(const int* weights, const int* lens, int n, BTNode** leaves = nullptr) {
+            if (!weights || !lens || n <= 0) return nullptr;
+            int* order = static_cast<int*>(std::malloc(sizeof(int) * static_cast<std::size_t>(n)));
+            if (!order) return nullptr;
+            for (int i = 0; i < n; ++i) order[i] = i;
+            std::sort(order, order + n, [lens](int a, int b) {
+                return lens[a] != lens[b] ? lens[a] < lens[b] : a < b;
+            });
+
+            BTNode* root = buildNode(0);
+            bool ok = root != nullptr;
+            unsigned long long code = 0;
+            int prevLen = lens[order[0]];
+            for (int j = 0; j < n && ok; ++j) {
+                const int i = order[j];
+                const int len = lens[i];
+                if (len < 1 || len > 62) { ok = false; break; }
+                if (j > 0) code = (code + 1) << (len - prevLen);
+                prevLen = len;
+                if (code >> len) { ok = false; break; }  // 码字用完了：不满足 Kraft 不等式
+                // 码长非降、码字递增且不越界时，范式码天然是前缀码，沿路径缺哪个结点补哪个即可
+                BTNode* p = root;
+                for (int k = len - 1; k >= 0; --k) {
+                    BTNode*& next = ((code >> k) & 1) ? p->right : p->left;
+                    if (!next && !(next = buildNode(0))) { ok = false; break; }
+                    p = next;
+                }
+                if (ok) p->key = weights[i];
+                if (ok && leaves) leaves[i] = p;
+            }
+            std::free(order);
+            if (!ok) {
+                freeTree(root);  // 归还已建好的部分
+                return nullptr;
             }
 
-            rootNode = forest[0];
-            std::free(forest);
+            postorderWalk(root, [](BTNode* p) {
+                if (p->left || p->right) p->key = (p->left ? p->left->key : 0) + (p->right ? p->right->key : 0);
+            });
+            return root;
         }
 
-        // 直接造一个结点（可能给外面用）
-        static BTNode* makeNode(int key) { return buildNode(key); }
+        // 直接造一个结点（可能给外面用），结点属于本树，随 clear() 一起回收
+        BTNode* makeNode(int key) { return buildNode(key); }
     };
 } // namespace ds
 #endif // HUFFMAN_H
@@ -0,0 +1,309 @@
+//
+// Created by xiang on 26-10-17.
+//
+
+#ifndef HUFFMANCODEC_H
+#define HUFFMANCODEC_H
+
+#include "huffman.h"
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace ds {
+
+    // 字节流的哈夫曼编解码（范式哈夫曼码）
+    // - 码长由 Huffman::codeLengths 按字节频次建树得到（可用 package-merge 限长），码字只由码长决定（范式码），所以数据头里只需存 256 个码长；
+    // - 编码：64 位位缓冲，攒满 32 位整块写出；
+    // - 解码：先查 2^kTableBits 项的表，一次得到符号和码长；码长超过 kTableBits 的少数长码再按范式码逐个长度比较。
+    // 码字按高位在前写入，和界面上树的 0/1 路径一致。
+    class HuffmanCodec {
+    public:
+        static constexpr int kSymbols = 256;
+        static constexpr int kTableBits = 11;    // 一级解码表 2048 项
+        static constexpr int kMaxCodeLen = 56;   // 解码时位缓冲补满后至少有 57 位，码长不能超过它
+
+        HuffmanCodec() { std::memset(len_, 0, sizeof(len_)); }
+
+        // 统计字节频次（四组计数交替累加，减少相邻相同字节造成的写后读停顿）
+        static void countBytes(const std::uint8_t* data, std::size_t n, std::uint64_t freq[kSymbols]) {
+            std::uint32_t c[4][kSymbols];
+            std::memset(c, 0, sizeof(c));
+            for (int s = 0; s < kSymbols; ++s) freq[s] = 0;
+            std::size_t i = 0;
+            while (i < n) {
+                // 分段累加，保证 32 位计数不溢出
+                const std::size_t end = (n - i > (1u << 30)) ? i + (1u << 30) : n;
+                for (; i + 4 <= end; i += 4) {
+                    ++c[0][data[i]];
+                    ++c[1][data[i + 1]];
+                    ++c[2][data[i + 2]];
+                    ++c[3][data[i + 3]];
+                }
+                for (; i < end; ++i) ++c[0][data[i]];
+                for (int s = 0; s < kSymbols; ++s) {
+                    freq[s] += std::uint64_t(c[0][s]) + c[1][s] + c[2][s] + c[3][s];
+                    c[0][s] = c[1][s] = c[2][s] = c[3][s] = 0;
+                }
+            }
+        }
+
+        // 按频次建哈夫曼树求码长，再生成范式码；没有任何非零频次时返回 false
+        // 频次总和超过 int 时按比例缩小（非零频次至少保留 1），码长仍是合法前缀码，只是不再严格最优
+        // maxLen > 0 且哈夫曼码长超过它时改用 package-merge 限长（例如 maxLen <= kTableBits 时解码全部一次查表）
+        bool build(const std::uint64_t freq[kSymbols], int maxLen = 0) {
+            int syms[kSymbols];
+            int w[kSymbols];
+            int m = 0;
+            std::uint64_t total = 0;
+            for (int s = 0; s < kSymbols; ++s) {
+                if (freq[s]) {
+                    syms[m++] = s;
+                    total += freq[s];
+                }
+            }
+            if (m == 0) return false;
+
+            int shift = 0;
+            while ((total >> shift) + kSymbols > std::uint64_t(INT_MAX)) ++shift;
+            for (int i = 0; i < m; ++i) {
+                const std::uint64_t v = freq[syms[i]] >> shift;
+                w[i] = v ? static_cast<int>(v) : 1;
+            }
+
+            int len[kSymbols];
+            if (!Huffman::codeLengths(w, m, len)) return false;
+            if (maxLen > 0) {
+                int deepest = 0;
+                for (int i = 0; i < m; ++i) deepest = len[i] > deepest ? len[i] : deepest;
+                if (deepest > maxLen && !Huffman::limitedCodeLengths(w, m, maxLen, len)) return false;
+            }
+            std::uint8_t lens[kSymbols];
+            std::memset(lens, 0, sizeof(lens));
+            for (int i = 0; i < m; ++i) lens[syms[i]] = static_cast<std::uint8_t>(len[i]);
+            return setLengths(lens);
+        }
+
+        // 由码长表生成范式码和解码表（解码端从数据头读出码长后调用）
+        // 码长为 0 表示该字节不出现；码长超过 kMaxCodeLen 或不满足 Kraft 不等式时返回 false
+        bool setLengths(const std::uint8_t lens[kSymbols]) {
+            int count[kMaxCodeLen + 1] = {};
+            std::uint64_t kraft = 0;
+            int maxLen = 0;
+            for (int s = 0; s < kSymbols; ++s) {
+                const int l = lens[s];
+                if (l > kMaxCodeLen) return false;
+                if (!l) continue;
+                ++count[l];
+                kraft += std::uint64_t(1) << (kMaxCodeLen - l);
+                if (kraft > (std::uint64_t(1) << kMaxCodeLen)) return false;
+                if (l > maxLen) maxLen = l;
+            }
+            if (maxLen == 0) return false;
+
+            // 范式码：同一码长的码字连续递增，码长加一时左移一位
+            std::uint64_t next = 0;
+            int offset = 0;
+            for (int l = 1; l <= kMaxCodeLen; ++l) {
+                first_[l] = next;
+                count_[l] = count[l];
+                offset_[l] = offset;
+                offset += count[l];
+                next = (next + count[l]) << 1;
+            }
+            int fill[kMaxCodeLen + 1];
+            for (int l = 1; l <= kMaxCodeLen; ++l) fill[l] = offset_[l];
+            for (int s = 0; s < kSymbols; ++s) {
+                const int l = lens[s];
+                len_[s] = static_cast<std::uint8_t>(l);
+                if (!l) continue;
+                code_[s] = first_[l] + std::uint64_t(fill[l] - offset_[l]);
+                sorted_[fill[l]++] = static_cast<std::uint8_t>(s);
+            }
+            maxLen_ = maxLen;
+
+            // 一级表：码长 l <= kTableBits 的码字占 2^(kTableBits-l) 个连续表项；0 表示要走长码
+            std::memset(table_, 0, sizeof(table_));
+            for (int s = 0; s < kSymbols; ++s) {
+                const int l = len_[s];
+                if (!l || l > kTableBits) continue;
+                const std::uint32_t lo = static_cast<std::uint32_t>(code_[s] << (kTableBits - l));
+                const std::uint32_t hi = lo + (1u << (kTableBits - l));
+                for (std::uint32_t k = lo; k < hi; ++k) table_[k] = static_cast<std::uint16_t>((l << 8) | s);
+            }
+            return true;
+        }
+
+        const std::uint8_t* lengths() const { return len_; }
+        int length(int sym) const { return len_[sym]; }
+        std::uint64_t code(int sym) const { return code_[sym]; }
+        int maxLength() const { return maxLen_; }
+
+        // 按当前码表编码这些频次需要的位数
+        std::uint64_t encodedBits(const std::uint64_t freq[kSymbols]) const {
+            std::uint64_t bits = 0;
+            for (int s = 0; s < kSymbols; ++s) bits += freq[s] * len_[s];
+            return bits;
+        }
+
+        // 编码 in[0..n) 到 out，返回写出的字节数；out 至少要有 (encodedBits + 7) / 8 字节
+        // 出现了码表里没有的字节返回 0（n 为 0 时也返回 0）
+        std::size_t encode(const std::uint8_t* in, std::size_t n, std::uint8_t* out) const {
+            BitWriter bw(out);
+            for (std::size_t i = 0; i < n; ++i) {
+                const int s = in[i];
+                const int l = len_[s];
+                if (!l) return 0;
+                const std::uint64_t c = code_[s];
+                if (l <= 32) {
+                    bw.put(static_cast<std::uint32_t>(c), l);
+                } else {
+                    bw.put(static_cast<std::uint32_t>(c >> 32), l - 32);
+                    bw.put(static_cast<std::uint32_t>(c), 32);
+                }
+            }
+            return bw.finish();
+        }
+
+        // 从 in[0..inBytes) 解出 n 个字节到 out；码流损坏或长度不够返回 false
+        bool decode(const std::uint8_t* in, std::size_t inBytes, std::uint8_t* out, std::size_t n) const {
+            if (maxLen_ == 0) return n == 0;
+            BitReader br(in, inBytes);
+            for (std::size_t i = 0; i < n; ++i) {
+                if (br.cnt < maxLen_) br.refill();
+                const std::uint16_t e = table_[br.buf >> (64 - kTableBits)];
+                int l = e >> 8;
+                int s = e & 0xFF;
+                if (!l) {
+                    // 长码：依次取 kTableBits+1、+2 ... 位，落在该码长的码字区间内即命中
+                    for (l = kTableBits + 1; l <= maxLen_; ++l) {
+                        const std::uint64_t c = br.buf >> (64 - l);
+                        const std::uint64_t k = c - first_[l];
+                        if (c >= first_[l] && k < std::uint64_t(count_[l])) {
+                            s = sorted_[offset_[l] + static_cast<int>(k)];
+                            break;
+                        }
+                    }
+                    if (l > maxLen_) return false;
+                }
+                out[i] = static_cast<std::uint8_t>(s);
+                br.buf <<= l;
+                br.cnt -= l;
+            }
+            return br.consumedBits() <= std::uint64_t(inBytes) * 8;
+        }
+
+        // 自带数据头的整块压缩：魔数 "HUF1" + 原长（8 字节）+ 256 个码长 + 码流；maxLen 同 build
+        static bool compress(const std::uint8_t* in, std::size_t n, std::vector<std::uint8_t>& out, int maxLen = 0) {
+            std::uint64_t freq[kSymbols];
+            countBytes(in, n, freq);
+            HuffmanCodec codec;
+            if (n > 0 && !codec.build(freq, maxLen)) return false;
+            const std::size_t payload = static_cast<std::size_t>((codec.encodedBits(freq) + 7) / 8);
+            out.assign(kHeaderBytes + payload, 0);
+            std::uint8_t* h = out.data();
+            std::memcpy(h, "HUF1", 4);
+            for (int k = 0; k < 8; ++k) h[4 + k] = static_cast<std::uint8_t>(std::uint64_t(n) >> (56 - 8 * k));
+            std::memcpy(h + 12, codec.len_, kSymbols);
+            return n == 0 || codec.encode(in, n, h + kHeaderBytes) == payload;
+        }
+
+        static bool decompress(const std::uint8_t* in, std::size_t n, std::vector<std::uint8_t>& out) {
+            if (!in || n < kHeaderBytes || std::memcmp(in, "HUF1", 4) != 0) return false;
+            std::uint64_t len = 0;
+            for (int k = 0; k < 8; ++k) len = (len << 8) | in[4 + k];
+            HuffmanCodec codec;
+            if (len == 0) {
+                out.clear();
+                return true;
+            }
+            if (!codec.setLengths(in + 12)) return false;
+            // 每个字节至少占一位，原长不可能超过码流位数
+            if (len > std::uint64_t(n - kHeaderBytes) * 8) return false;
+            out.resize(static_cast<std::size_t>(len));
+            return codec.decode(in + kHeaderBytes, n - kHeaderBytes, out.data(), out.size());
+        }
+
+        static constexpr std::size_t kHeaderBytes = 4 + 8 + kSymbols;
+
+    private:
+        std::uint8_t len_[kSymbols];
+        std::uint64_t code_[kSymbols] = {};
+        // 范式码解码用：码长 l 的码字为 first_[l] .. first_[l]+count_[l]-1，对应 sorted_[offset_[l] ..]
+        std::uint64_t first_[kMaxCodeLen + 1] = {};
+        int count_[kMaxCodeLen + 1] = {};
+        int offset_[kMaxCodeLen + 1] = {};
+        std::uint8_t sorted_[kSymbols] = {};
+        std::uint16_t table_[1 << kTableBits] = {};  // (码长 << 8) | 符号
+        int maxLen_ = 0;
+
+        // 位缓冲写出：低 nbits 位是还没写出的位，攒够 32 位就整块写出（高位在前）
+        class BitWriter {
+            std::uint8_t* out;
+            std::size_t pos = 0;
+            std::uint64_t acc = 0;
+            int nbits = 0;
+        public:
+            explicit BitWriter(std::uint8_t* o) : out(o) {}
+            void put(std::uint32_t code, int len) {  // len <= 32
+                acc = (acc << len) | code;
+                nbits += len;
+                if (nbits >= 32) {
+                    nbits -= 32;
+                    const std::uint32_t w = static_cast<std::uint32_t>(acc >> nbits);
+                    out[pos] = static_cast<std::uint8_t>(w >> 24);
+                    out[pos + 1] = static_cast<std::uint8_t>(w >> 16);
+                    out[pos + 2] = static_cast<std::uint8_t>(w >> 8);
+                    out[pos + 3] = static_cast<std::uint8_t>(w);
+                    pos += 4;
+                }
+            }
+            // 剩余不足 32 位的部分补 0 到整字节写出，返回总字节数
+            std::size_t finish() {
+                while (nbits > 0) {
+                    const int take = nbits >= 8 ? 8 : nbits;
+                    nbits -= take;
+                    out[pos++] = static_cast<std::uint8_t>(((acc >> nbits) & ((1u << take) - 1)) << (8 - take));
+                }
+                return pos;
+            }
+        };
+
+        // 位缓冲读入：buf 的高 cnt 位是待解码的位；读过末尾时补 0，最后用 consumedBits 检查是否越界
+        struct BitReader {
+            const std::uint8_t* in;
+            std::size_t n;
+            std::size_t pos = 0;   // 已装入缓冲的字节数（可能超过 n，超出部分是补的 0）
+            std::uint64_t buf = 0;
+            int cnt = 0;
+
+            BitReader(const std::uint8_t* p, std::size_t size) : in(p), n(size) {}
+
+            void refill() {
+                if (pos + 8 <= n) {
+                    // 一次装入 8 字节，只记整字节数；多装进来的低位就是后面的字节，下次会原样再装一遍
+                    std::uint64_t w = 0;
+                    for (int k = 0; k < 8; ++k) w = (w << 8) | in[pos + k];
+                    buf |= w >> cnt;
+                    const int take = (63 - cnt) >> 3;
+                    pos += static_cast<std::size_t>(take);
+                    cnt += take * 8;
+                } else {
+                    while (cnt <= 56) {
+                        const std::uint64_t b = pos < n ? in[pos] : 0;
+                        buf |= b << (56 - cnt);
+                        ++pos;
+                        cnt += 8;
+                    }
+                }
+            }
+
+            std::uint64_t consumedBits() const { return std::uint64_t(pos) * 8 - static_cast<std::uint64_t>(cnt); }
+        };
+    };
+
+} // namespace ds
+
+#endif // HUFFMANCODEC_H
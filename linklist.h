@@ -5,6 +5,9 @@
 #define LINKLIST_H
 
 #include <cstdlib>
+#include <cstddef>
+#include <iterator>
+#include "nodepool.h"
 
 namespace ds {
 
@@ -17,10 +20,30 @@ namespace ds {
         LLNode *head;
         LLNode *tail;
         int length;
+        NodePool<LLNode> pool;  // 结点池：结点成块申请，clear() 后整块复用
+
+        // “手指”：缓存最近一次按下标访问到的结点，后续访问若不在它前面就从这里继续走
+        mutable LLNode *finger;
+        mutable int fingerPos;
+
+        // 定位到 position 位置的结点（调用方保证 0 <= position < length）
+        LLNode* nodeAt(int position) const {
+            if (position == length - 1) return tail;
+            LLNode* p = head;
+            int i = 0;
+            if (finger && fingerPos <= position) {
+                p = finger;
+                i = fingerPos;
+            }
+            while (p && i < position) { p = p->next; ++i; }
+            finger = p;
+            fingerPos = i;
+            return p;
+        }
 
         // 新建一个节点
         LLNode* build(int v) {
-            LLNode* p = static_cast<LLNode*>(std::malloc(sizeof(LLNode)));
+            LLNode* p = pool.alloc();
             if (!p) return nullptr;
             p->value = v;
             p->next  = nullptr;
@@ -28,12 +51,16 @@ namespace ds {
         }
 
     public:
-        Linklist() : head(nullptr), tail(nullptr), length(0) {}
+        Linklist() : head(nullptr), tail(nullptr), length(0), finger(nullptr), fingerPos(0) {}
 
         ~Linklist() {
             clear();
         }
 
+        // 结点归结点池所有，禁止浅拷贝
+        Linklist(const Linklist&) = delete;
+        Linklist& operator=(const Linklist&) = delete;
+
         // 长度
         int size() const {
             return length;
@@ -44,15 +71,39 @@ namespace ds {
             return head;
         }
 
-        // 清空链表
+        // 只读前向迭代器：顺序遍历每个结点的值，整趟 O(n)
+        class const_iterator {
+            const LLNode* p;
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = int;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = const int*;
+            using reference         = const int&;
+
+            const_iterator() : p(nullptr) {}
+            explicit const_iterator(const LLNode* node) : p(node) {}
+
+            reference operator*() const { return p->value; }
+            pointer operator->() const { return &p->value; }
+            const_iterator& operator++() { p = p->next; return *this; }
+            const_iterator operator++(int) { const_iterator t = *this; p = p->next; return t; }
+            bool operator==(const const_iterator& o) const { return p == o.p; }
+            bool operator!=(const const_iterator& o) const { return p != o.p; }
+
+            // 当前结点（画图时需要结点指针）
+            const LLNode* node() const { return p; }
+        };
+
+        const_iterator begin() const { return const_iterator(head); }
+        const_iterator end() const { return const_iterator(nullptr); }
+
+        // 清空链表：结点池整体回收，不逐个释放
         void clear() {
-            LLNode* p = head;
-            while (p) {
-                LLNode* q = p->next;
-                std::free(p);
-                p = q;
-            }
+            pool.reset();
             head = tail = nullptr;
+            finger = nullptr;
+            fingerPos = 0;
             length = 0;
         }
 
@@ -63,6 +114,7 @@ namespace ds {
             p->next = head;
             head = p;
             if (!tail) tail = p;
+            if (finger) ++fingerPos; // 手指指向的结点整体后移一位
             ++length;
         }
 
@@ -91,12 +143,7 @@ namespace ds {
                 return true;
             }
 
-            int i = 0;
-            LLNode* prev = head;
-            while (prev && i < position - 1) {
-                prev = prev->next;
-                ++i;
-            }
+            LLNode* prev = nodeAt(position - 1);
             if (!prev) return false;
 
             LLNode* p = build(value);
@@ -105,6 +152,7 @@ namespace ds {
             p->next = prev->next;
             prev->next = p;
             ++length;
+            // 手指停在 prev（position - 1），新结点之后的下标整体 +1 不影响它
             return true;
         }
 
@@ -113,31 +161,30 @@ namespace ds {
             if (position < 0 || position >= length || !head) return false;
             if (position == 0) {
                 LLNode* q = head->next;
-                std::free(head);
+                if (finger == head) finger = nullptr;
+                else if (finger) --fingerPos;
+                pool.release(head);
                 head = q;
                 if (!head) tail = nullptr;
                 --length;
                 return true;
             }
 
-            int i = 0;
-            LLNode* prev = head;
-            while (prev && prev->next && i < position - 1) { prev = prev->next; ++i; }
+            LLNode* prev = nodeAt(position - 1);
             if (!prev || !prev->next) return false;
 
             LLNode* cur = prev->next;
             prev->next = cur->next;
             if (cur == tail) tail = prev;
-            std::free(cur);
+            pool.release(cur);
             --length;
             return true;
         }
         // 获取 position 位置的值，不合法返回 0
+        // 从手指处继续走：按下标递增顺序访问时均摊 O(1)
         int get(int position) const {
             if (position < 0 || position >= length) return 0;
-            int i = 0;
-            LLNode* p = head;
-            while (p && i < position) { p = p->next; ++i; }
+            LLNode* p = nodeAt(position);
             return p ? p->value : 0;
         }
     };
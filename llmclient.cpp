@@ -48,13 +48,27 @@ QString LLMClient::buildSystemPrompt() const
         "  初始建立:    seq 1 3 5 7\n"
         "  插入元素:    seq.insert pos value   （pos 为下标，从 0 开始）\n"
         "  删除元素:    seq.erase pos\n"
+        "  连续删除:    seq.erase pos count   （从 pos 起删除 count 个）\n"
         "  清空:        seq.clear\n"
+        "  查找:        seq.find value   （返回第一个等于 value 的下标）\n"
+        "  计数:        seq.count value\n"
+        "  第一个大于:  seq.gt value\n"
+        "  最小/最大/求和: seq.min / seq.max / seq.sum\n"
         "\n"
         "【单链表 Linklist】\n"
         "  初始建立:    link 2 4 6 8\n"
         "  插入元素:    link.insert pos value\n"
         "  删除元素:    link.erase pos\n"
         "  清空:        link.clear\n"
+        "  存储方式:    link.mode unrolled   （块状链表） / link.mode doubly （双链表） / link.mode node （普通单链表）\n"
+        "\n"
+        "【双链表 DLinklist】\n"
+        "  初始建立:    dlink 2 4 6 8\n"
+        "  插入元素:    dlink.insert pos value\n"
+        "  删除元素:    dlink.erase pos\n"
+        "  头删/尾删:   dlink.popfront / dlink.popback\n"
+        "  按位访问:    dlink.get pos\n"
+        "  清空:        dlink.clear\n"
         "\n"
         "【顺序栈 Stack】\n"
         "  初始建立:    stack 3 8 13\n"
@@ -78,15 +92,21 @@ QString LLMClient::buildSystemPrompt() const
         "  查找:        bst.find value\n"
         "  插入:        bst.insert value\n"
         "  删除:        bst.erase value\n"
+        "  第k小:       bst.kth k（k 从 1 开始）\n"
+        "  平衡化:      bst.balance\n"
         "  清空:        bst.clear\n"
         "\n"
         "【哈夫曼树 Huffman】\n"
         "  建立:        huff 5 9 12 13 16 45\n"
+        "  限长编码:    huff.limit L [权值...]（最大码长 L，不给权值则用当前权值）\n"
+        "  编码文件:    huff.encode <文件路径>（路径原样保留大小写）\n"
         "  清空:        huff.clear\n"
         "\n"
         "【AVL 树】\n"
         "  建立:        avl 10 20 30 40\n"
         "  插入:        avl.insert value\n"
+        "  删除:        avl.erase value\n"
+        "  排名:        avl.rank value（比 value 小的键数）\n"
         "  清空:        avl.clear\n"
         "\n"
         "请根据用户的自然语言，选择一种最合适的数据结构，并用上述 DSL 命令写出脚本。\n"
@@ -36,11 +36,15 @@
 #include "canvas.h"
 #include "seqlist.h"
 #include "linklist.h"
+#include "unrolledlinklist.h"
+#include "dlinklist.h"
 #include "stack.h"
 #include "binarytree.h"
 #include "binarysearchtree.h"
 #include "huffman.h"
+#include "huffmancodec.h"
 #include "avl.h"
+#include "persistentavl.h"
 #include "llmclient.h"
 
 class MainWindow : public QMainWindow {
@@ -80,15 +84,21 @@ private slots:
     void bstFind();
     void bstInsert();
     void bstErase();
+    void bstBalance();
+    void bstKth();
     void bstClear();
 
     // 哈夫曼树
     void huffmanBuild();
     void huffmanClear();
+    void huffmanLimit();
+    void huffmanEncodeFile(const QString& path);
 
     // AVL树
     void avlBuild();
     void avlInsert();
+    void avlErase();
+    void avlRank();
     void avlClear();
 
     // 画布缩放
@@ -128,13 +138,19 @@ private slots:
 
 
 private:
-    ds::Seqlist seq;
+    ds::Seqlist<int> seq;
     ds::Linklist link;
+    ds::UnrolledLinklist<> ulink;   // 链表的“块状”存储模式（每块一条缓存行）
+    ds::DLinklist dlink;            // 链表的“双链表”存储模式（带 prev 指针）
+    // 链表页当前的存储方式（与“存储方式”下拉框的下标一致）
+    enum class LinkMode { Node, Unrolled, Doubly };
+    LinkMode linkMode_ = LinkMode::Node;
     ds::Stack st;
     ds::BinaryTree bt;
     ds::BinarySearchTree bst;
     ds::Huffman huff;
     ds::AVL avl;
+    ds::PersistentAVL avlHistory;    // AVL 动画用的只读版本：每一步持有版本根直接绘制，不再重放插入
     // 布局核心
     QSplitter* splitter{};
     Canvas* view{};                  // 左侧画布
@@ -158,18 +174,42 @@ private:
     void onAnimSpeedChanged(int value); // 速度滑块回调
 
     // 绘制助手
-    void drawSeqlist(const ds::Seqlist& sl);
+    void drawSeqlist(const ds::Seqlist<int>& sl, int highlightIdx = -1);
+    // 顺序表查询（DSL：seq.find/count/min/max/sum/gt），结果写到消息栏并高亮命中位置
+    void seqlistQuery(const QString& op, int arg);
     void drawLinklist(const ds::Linklist& ll);
+    void drawUnrolledLinklist(const ds::UnrolledLinklist<>& ul, int highlightPos = -1);
+    // 按块的快照绘制（每个内层 QVector 是一块里的值）；插入/删除动画用它画操作前后的真实块布局
+    void drawUnrolledBlocks(const QVector<QVector<int>>& blocks, int highlightPos = -1);
+    // 切换链表存储方式（内容原样搬到另一种结构）
+    void setLinklistMode(LinkMode mode);
+    void drawCurrentLinklist();
+    // 块状链表模式下的建立/插入/删除（按块分段绘制）
+    void unrolledBuild(const QVector<int>& a);
+    void unrolledInsert(int pos, int value);
+    void unrolledErase(int pos);
+    // 双链表模式：next 画在上方、prev 画在下方，插入/删除逐步演示两个方向的指针修改
+    void drawDLinklist(const ds::DLinklist& dl, int highlightPos = -1);
+    void dlinkBuild(const QVector<int>& a);
+    void dlinkInsert(int pos, int value);
+    void dlinkErase(int pos);
+    void dlinkGet(int pos);     // 从较近的一端走到 pos
     void drawStack(const ds::Stack& st);
     void drawBT(ds::BTNode* root, qreal x, qreal y, qreal distance, int highlightKey=-99999);
-    // 追加一次 AVL 插入动画步骤（不会 stop timer / clear steps）
-    void drawAVL(int value, const QVector<int>& restoreKeys, int idx, int total);
+    void drawHuffmanTree(ds::BTNode* n, qreal x, qreal y, qreal dist, const QString& prefix, bool annotateCodes);
+    void fillHuffmanCodeTable(ds::BTNode* root);
+    // 追加一次 AVL 插入动画步骤（不会 stop timer / clear steps）：before/after 是 avlHistory 中插入前后的版本
+    void drawAVL(int value, ds::PersistentAVL::Version before, ds::PersistentAVL::Version after,
+                 const std::vector<ds::AVL::RotationRecord>& recs, int idx, int total);
+    // 追加一次 AVL 删除动画步骤：先画 BST 删除后的形态，再按旋转记录逐次播放（recs 只在调用时读取其中的键）
+    void drawAVLErase(int value, ds::PersistentAVL::Version before, ds::PersistentAVL::Version after,
+                      const std::vector<ds::AVL::RotationRecord>& recs);
 
     // 右侧控件
     // 顺序表
     QLineEdit* seqlistInput{}; QLineEdit* seqlistValue{}; QSpinBox* seqlistPosition{};
     // 链表
-    QLineEdit* linklistInput{}; QLineEdit* linklistValue{}; QSpinBox* linklistPosition{};
+    QLineEdit* linklistInput{}; QLineEdit* linklistValue{}; QSpinBox* linklistPosition{}; QComboBox* linklistMode{};
     // 栈
     QLineEdit* stackInput{}; QLineEdit* stackValue{};
     // 二叉树
@@ -177,7 +217,7 @@ private:
     // BST
     QLineEdit* bstInput{}; QLineEdit* bstValue{};
     // 哈夫曼
-    QLineEdit* huffmanInput{}; QTableWidget* huffmanCodeTable{};
+    QLineEdit* huffmanInput{}; QTableWidget* huffmanCodeTable{}; QSpinBox* huffmanMaxLen{};
     // AVL树
     QLineEdit* avlInput{}; QLineEdit* avlValue{};
 
@@ -116,7 +116,12 @@ void MainWindow::saveDoc() {
         {
             QJsonObject obj;
             QJsonArray arr;
-            for(int i = 0; i < link.size(); ++i) arr.push_back(link.get(i));
+            // 迭代器顺序遍历，O(n)
+            switch (linkMode_) {
+            case LinkMode::Node:     for(int v : link)  arr.push_back(v); obj["mode"] = "node";     break;
+            case LinkMode::Unrolled: for(int v : ulink) arr.push_back(v); obj["mode"] = "unrolled"; break;
+            case LinkMode::Doubly:   for(int v : dlink) arr.push_back(v); obj["mode"] = "doubly";   break;
+            }
             obj["values"] = arr;
             root["linkedlist"] = obj;
         }
@@ -216,13 +221,24 @@ void MainWindow::openDoc() {
         auto o = doc.object();
         if (o.contains("seqlist")) {
             QJsonObject s = o["seqlist"].toObject();
-            seq.clear();
-            for (auto v : s["values"].toArray()) seq.insert(seq.size(), v.toInt());
+            const QJsonArray arr = s["values"].toArray();
+            QVector<int> vals; vals.reserve(arr.size());
+            for (auto v : arr) vals.push_back(v.toInt());
+            seq.assign(vals.constData(), vals.constData() + vals.size()); // 一次预留、一次拷贝
         }
         if (o.contains("linkedlist")) {
             QJsonObject s = o["linkedlist"].toObject();
-            link.clear();
-            for (auto v : s["values"].toArray()) link.insert(link.size(), v.toInt());
+            const QString mode = s["mode"].toString();
+            setLinklistMode(mode == "unrolled" ? LinkMode::Unrolled
+                          : mode == "doubly"   ? LinkMode::Doubly : LinkMode::Node);
+            link.clear(); ulink.clear(); dlink.clear();
+            for (auto v : s["values"].toArray()) {
+                switch (linkMode_) {
+                case LinkMode::Node:     link.push_back(v.toInt());  break;
+                case LinkMode::Unrolled: ulink.push_back(v.toInt()); break;
+                case LinkMode::Doubly:   dlink.push_back(v.toInt()); break;
+                }
+            }
             setProperty("linkBuilt", true);
         }
         if (o.contains("stack")) {
@@ -239,7 +255,9 @@ void MainWindow::openDoc() {
         }
         if (o.contains("bst")) {
             QJsonObject s = o["bst"].toObject();
-            bst.clear(); for (auto v : s["preorder"].toArray()) bst.insert(v.toInt());
+            // 先序序列按原顺序插入就是原来的形状，bulkLoad 一次建好，不再逐个插入
+            QVector<int> pre; for (auto v : s["preorder"].toArray()) pre.push_back(v.toInt());
+            bst.bulkLoad(pre.data(), pre.size(), ds::BinarySearchTree::LoadMode::InsertionOrder);
         }
         if (o.contains("avl")) {
             QJsonObject s = o["avl"].toObject();
@@ -442,7 +460,15 @@ void MainWindow::onModuleChanged(int index) {
     case 1: // 单链表
         currentKind_ = DocKind::LinkedList;
         view->setCurrentFamily(QStringLiteral("link"));
-        if (link.size() > 0) { drawLinklist(link); view->setTitle(QStringLiteral("单链表")); }
+        if (linkMode_ == LinkMode::Unrolled) {
+            if (ulink.size() > 0) { drawUnrolledLinklist(ulink); view->setTitle(QStringLiteral("块状链表")); }
+            else { view->setTitle(QStringLiteral("块状链表（空）")); }
+        }
+        else if (linkMode_ == LinkMode::Doubly) {
+            if (dlink.size() > 0) { drawDLinklist(dlink); view->setTitle(QStringLiteral("双链表")); }
+            else { view->setTitle(QStringLiteral("双链表（空）")); }
+        }
+        else if (link.size() > 0) { drawLinklist(link); view->setTitle(QStringLiteral("单链表")); }
         else { view->setTitle(QStringLiteral("单链表（空）")); }
         break;
     case 2: // 栈
@@ -514,7 +540,14 @@ void MainWindow::insertDSLExample() {
 <pre><code>seq 1 3 5 7
 seq.insert pos value
 seq.erase pos
+seq.erase pos count
 seq.clear
+seq.find v
+seq.count v
+seq.gt v
+seq.min
+seq.max
+seq.sum
 </code></pre>
 
 <h3>单链表（Linklist）</h3>
@@ -522,6 +555,19 @@ seq.clear
 link.insert pos value
 link.erase pos
 link.clear
+link.mode unrolled
+link.mode doubly
+link.mode node
+</code></pre>
+
+<h3>双链表（DLinklist，链表页的双链表存储方式）</h3>
+<pre><code>dlink 2 4 6 8
+dlink.insert pos value
+dlink.erase pos
+dlink.popfront
+dlink.popback
+dlink.get pos
+dlink.clear
 </code></pre>
 
 <h3>顺序栈（Stack）</h3>
@@ -545,17 +591,23 @@ bt.clear
 bst.find x
 bst.insert x
 bst.erase x
+bst.kth k
+bst.balance
 bst.clear
 </code></pre>
 
 <h3>哈夫曼树（Huffman）</h3>
 <pre><code>huff 5 9 12 13 16 45
+huff.limit L [w1 w2 ...]
+huff.encode file
 huff.clear
 </code></pre>
 
 <h3>AVL 树</h3>
 <pre><code>avl 10 20 30 40 50 25
 avl.insert x
+avl.erase x
+avl.rank x
 avl.clear
 </code></pre>
 
@@ -685,9 +737,30 @@ void MainWindow::runDSL() {
             }
         }
         if (s.startsWith("seq.erase")) {
-            // seq.erase pos
+            // seq.erase pos [count]
             auto tokens = s.split(QRegularExpression("\\s+"));
-            if (tokens.size() >= 2) {
+            if (tokens.size() >= 3) {
+                // 带 count：连续删除一段，只挪动一次尾部；count 为 0 不删，为负拒绝
+                bool ok1=false, ok2=false;
+                int pos = tokens.value(1).toInt(&ok1);
+                int cnt = tokens.value(2).toInt(&ok2);
+                if (ok1 && ok2) {
+                    ops.push_back([=, this](){
+                        currentKind_ = DocKind::SeqList;
+                        timer.stop(); steps.clear(); stepIndex = 0;
+                        if (cnt < 0) {
+                            showMessage(QStringLiteral("顺序表：删除失败(count 不能为负：%1)").arg(cnt));
+                        } else if (seq.erase_range(pos, cnt)) {
+                            drawSeqlist(seq);
+                            showMessage(QStringLiteral("顺序表：已删除 [%1, %2) 共 %3 个元素").arg(pos).arg(pos + cnt).arg(cnt));
+                        } else {
+                            showMessage(QStringLiteral("顺序表：删除失败(区间越界)"));
+                        }
+                    });
+                    continue;
+                }
+            }
+            if (tokens.size() == 2) {
                 bool ok=false; int pos = tokens.value(1).toInt(&ok);
                 if (ok) {
                     ops.push_back([=, this](){
@@ -700,6 +773,31 @@ void MainWindow::runDSL() {
                 }
             }
         }
+        if (s == "seq.min" || s == "seq.max" || s == "seq.sum") {
+            const QString op = s.mid(4);
+            ops.push_back([=, this](){
+                currentKind_ = DocKind::SeqList;
+                timer.stop(); steps.clear(); stepIndex = 0;
+                seqlistQuery(op, 0);
+            });
+            continue;
+        }
+        if (s.startsWith("seq.find") || s.startsWith("seq.count") || s.startsWith("seq.gt")) {
+            // seq.find v / seq.count v / seq.gt v
+            auto tokens = s.split(QRegularExpression("\\s+"));
+            if (tokens.size() >= 2) {
+                bool ok=false; int v = tokens.value(1).toInt(&ok);
+                if (ok) {
+                    const QString op = tokens[0].mid(4);
+                    ops.push_back([=, this](){
+                        currentKind_ = DocKind::SeqList;
+                        timer.stop(); steps.clear(); stepIndex = 0;
+                        seqlistQuery(op, v);
+                    });
+                    continue;
+                }
+            }
+        }
         if (s == "seq.clear") {
             ops.push_back([=, this](){
                 currentKind_ = DocKind::SeqList;
@@ -759,6 +857,21 @@ void MainWindow::runDSL() {
                 }
             }
         }
+        if (s.startsWith("link.mode")) {
+            // link.mode node|unrolled|doubly：切换链表的存储方式
+            auto tokens = s.split(QRegularExpression("\\s+"));
+            const QString m = tokens.value(1);
+            if (m == "node" || m == "unrolled" || m == "doubly") {
+                ops.push_back([=, this](){
+                    currentKind_ = DocKind::LinkedList;
+                    timer.stop(); steps.clear(); stepIndex = 0;
+                    setLinklistMode(m == "unrolled" ? LinkMode::Unrolled
+                                  : m == "doubly"   ? LinkMode::Doubly : LinkMode::Node);
+                    drawCurrentLinklist();
+                });
+                continue;
+            }
+        }
         if (s == "link.clear") {
             ops.push_back([=, this](){
                 currentKind_ = DocKind::LinkedList;
@@ -779,6 +892,73 @@ void MainWindow::runDSL() {
             continue;
         }
 
+        // ================= 双链表（链表页的双链表存储方式） =================
+        if (s.startsWith("dlink.insert")) {
+            // dlink.insert pos val
+            auto tokens = s.split(QRegularExpression("\\s+"));
+            if (tokens.size() >= 3) {
+                bool ok1=false, ok2=false;
+                int pos = tokens.value(1).toInt(&ok1);
+                int val = tokens.value(2).toInt(&ok2);
+                if (ok1 && ok2) {
+                    ops.push_back([=, this](){
+                        currentKind_ = DocKind::LinkedList;
+                        setLinklistMode(LinkMode::Doubly);
+                        timer.stop(); steps.clear(); stepIndex = 0;
+                        dlinkInsert(pos, val);
+                    });
+                    continue;
+                }
+            }
+        }
+        if (s.startsWith("dlink.erase") || s.startsWith("dlink.get")) {
+            // dlink.erase pos / dlink.get pos
+            auto tokens = s.split(QRegularExpression("\\s+"));
+            const bool isGet = s.startsWith("dlink.get");
+            if (tokens.size() >= 2) {
+                bool ok=false; int pos = tokens.value(1).toInt(&ok);
+                if (ok) {
+                    ops.push_back([=, this](){
+                        currentKind_ = DocKind::LinkedList;
+                        setLinklistMode(LinkMode::Doubly);
+                        timer.stop(); steps.clear(); stepIndex = 0;
+                        if (isGet) dlinkGet(pos); else dlinkErase(pos);
+                    });
+                    continue;
+                }
+            }
+        }
+        if (s == "dlink.popfront" || s == "dlink.popback") {
+            // 两端删除都是 O(1)
+            const bool back = (s == "dlink.popback");
+            ops.push_back([=, this](){
+                currentKind_ = DocKind::LinkedList;
+                setLinklistMode(LinkMode::Doubly);
+                timer.stop(); steps.clear(); stepIndex = 0;
+                dlinkErase(back ? dlink.size() - 1 : 0);
+            });
+            continue;
+        }
+        if (s == "dlink.clear") {
+            ops.push_back([=, this](){
+                currentKind_ = DocKind::LinkedList;
+                setLinklistMode(LinkMode::Doubly);
+                timer.stop(); steps.clear(); stepIndex = 0;
+                linklistClear();
+            });
+            continue;
+        }
+        if (s.startsWith("dlink ")) {
+            auto a = asNumbers(s);
+            ops.push_back([=, this](){
+                currentKind_ = DocKind::LinkedList;
+                setLinklistMode(LinkMode::Doubly);
+                timer.stop(); steps.clear(); stepIndex = 0;
+                dlinkBuild(a);
+            });
+            continue;
+        }
+
         // ================= 栈 =================
         if (s.startsWith("stack.push")) {
             // stack.push v
@@ -871,6 +1051,27 @@ void MainWindow::runDSL() {
             });
             continue;
         }
+        if (s == "bst.balance") {
+            ops.push_back([=, this](){
+                currentKind_ = DocKind::BST;
+                timer.stop(); steps.clear(); stepIndex = 0;
+                bstBalance();
+            });
+            continue;
+        }
+        if (s.startsWith("bst.kth")) {
+            auto tokens = s.split(QRegularExpression("\\s+"));
+            bool ok=false; int k = tokens.value(1).toInt(&ok);
+            if (ok) {
+                ops.push_back([=, this](){
+                    currentKind_ = DocKind::BST;
+                    bstValue->setText(QString::number(k));
+                    timer.stop(); steps.clear(); stepIndex = 0;
+                    bstKth();
+                });
+                continue;
+            }
+        }
         if (s.startsWith("bst.find") || s.startsWith("bst.insert") || s.startsWith("bst.erase")) {
             auto tokens = s.split(QRegularExpression("\\s+"));
             if (tokens.size() >= 2) {
@@ -927,6 +1128,34 @@ void MainWindow::runDSL() {
             });
             continue;
         }
+        if (s.startsWith("huff.limit")) {
+            // huff.limit L [w1 w2 ...]：不给权值时沿用输入框里的权值
+            auto a = asNumbers(s);
+            if (!a.isEmpty()) {
+                const int maxLen = a[0];
+                QString numbers; for (int i=1;i<a.size();++i){ if(i>1) numbers+=' '; numbers+=QString::number(a[i]); }
+                ops.push_back([=, this](){
+                    currentKind_ = DocKind::Huffman;
+                    if (!numbers.isEmpty()) huffmanInput->setText(numbers);
+                    huffmanMaxLen->setValue(maxLen);
+                    timer.stop(); steps.clear(); stepIndex = 0;
+                    huffmanLimit();
+                });
+                continue;
+            }
+        }
+        if (s.startsWith("huff.encode")) {
+            // 路径区分大小写且可能含空格：从原始行里取命令后面的全部内容
+            QString path = ln.trimmed().mid(QStringLiteral("huff.encode").size()).trimmed();
+            if (path.size() >= 2 && path.startsWith('"') && path.endsWith('"')) path = path.mid(1, path.size() - 2);
+            if (!path.isEmpty()) {
+                ops.push_back([=, this](){
+                    currentKind_ = DocKind::Huffman;
+                    huffmanEncodeFile(path);
+                });
+                continue;
+            }
+        }
         if (s.startsWith("huff ")) {
             auto a = asNumbers(s);
             QString numbers; for (int i=0;i<a.size();++i){ if(i) numbers+=' '; numbers+=QString::number(a[i]); }
@@ -948,16 +1177,19 @@ void MainWindow::runDSL() {
             });
             continue;
         }
-        if (s.startsWith("avl.insert")) {
+        if (s.startsWith("avl.insert") || s.startsWith("avl.erase") || s.startsWith("avl.rank")) {
             auto tokens = s.split(QRegularExpression("\\s+"));
             if (tokens.size() >= 2) {
                 bool ok=false; int v = tokens.value(1).toInt(&ok);
                 if (ok) {
+                    const QString cmd = tokens[0];
                     ops.push_back([=, this](){
                         currentKind_ = DocKind::AVL;
                         avlValue->setText(QString::number(v));
                         timer.stop(); steps.clear(); stepIndex = 0;
-                        avlInsert();
+                        if (cmd == "avl.erase") avlErase();
+                        else if (cmd == "avl.rank") avlRank();
+                        else avlInsert();
                     });
                     continue;
                 }
@@ -1188,16 +1420,12 @@ QVector<int> MainWindow::dumpBTLevel(ds::BTNode* root, int nullSentinel) const {
 
 // 把二叉树按先序遍历导出成整数数组
 void MainWindow::dumpPreorder(ds::BTNode* r, QVector<int>& out) const {
-    if(!r) return;
-    out.push_back(r->key);
-    dumpPreorder(r->left, out);
-    dumpPreorder(r->right, out);
+    ds::BinaryTree::preorderWalk(r, [&out](ds::BTNode* p){ out.push_back(p->key); });
 }
 
 // 遍历 Huffman 树并收集所有叶子结点的权值到数组中
 void MainWindow::collectLeafWeights(ds::BTNode* r, QVector<int>& out) const {
-    if(!r) return;
-    if(!r->left && !r->right) out.push_back(r->key);
-    collectLeafWeights(r->left, out);
-    collectLeafWeights(r->right, out);
+    ds::BinaryTree::preorderWalk(r, [&out](ds::BTNode* p){
+        if(!p->left && !p->right) out.push_back(p->key);
+    });
 }
\ No newline at end of file
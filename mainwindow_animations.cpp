@@ -12,7 +12,12 @@
 #include <QTableWidget>
 #include <QRegularExpression>
 #include <QPointF>
+#include <QSignalBlocker>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QFile>
 #include <cmath>
+#include <cstring>
 #include <memory>
 
 // 两个全局辅助变量和函数
@@ -34,8 +39,10 @@ void MainWindow::seqlistBuild()
     view->setTitle(QStringLiteral("顺序表：建立"));
 
     // 第 0 步：每次播放 / 重播时都从“空表”开始
-    steps.push_back([this]() {
+    const int total = a.size();
+    steps.push_back([this, total]() {
         seq.clear();  // 关键：重播时重新清空顺序表
+        seq.reserve(total);  // 一次预留到位，后续逐个插入不再触发扩容
         view->resetScene();
         view->setTitle(QStringLiteral("顺序表：建立"));
         drawSeqlist(seq);
@@ -43,6 +50,7 @@ void MainWindow::seqlistBuild()
     });
 
     // 后续步骤：逐个插入元素
+    // 这里故意不用 append_span 一次装入：建立动画要一步画一个新元素；尾部插入不挪动元素，容量已在第 0 步预留，每步 O(1)
     for (int x : a) {  //把 a 里面的每一个元素，挨个取出来，赋值给 x，执行后续操作。
         steps.push_back([this, x]() {
             seq.insert(seq.size(), x);
@@ -72,9 +80,10 @@ void MainWindow::seqlistInsert(){
     if (pos > n) pos = n;
 
     // 先把当前顺序表的值拷出来，用于纯前端动画
+    const QVector<int> vals(seq.data(), seq.data() + n);
     QVector<QString> arr(n);
     for (int i = 0; i < n; ++i)
-        arr[i] = QString::number(seq.get(i));
+        arr[i] = QString::number(vals[i]);
 
     const qreal cellW = 68;
     const qreal cellH = 54;
@@ -99,10 +108,7 @@ void MainWindow::seqlistInsert(){
     // 步骤 0：显示当前状态，高亮插入位置
     steps.push_back([=, this]() {
     // ★ 重播关键：每次播放前先把顺序表还原到“插入前”的状态
-    seq.clear();
-    for (int i = 0; i < n; ++i) {
-        seq.insert(i, arr[i].toInt());
-    }
+    seq.assign(vals.constData(), vals.constData() + n);
 
     view->resetScene();
     view->setTitle(QStringLiteral("顺序表：插入前（pos=%1）").arg(pos));
@@ -250,9 +256,10 @@ void MainWindow::seqlistErase(){
         return;
     }
 
+    const QVector<int> vals(seq.data(), seq.data() + n);
     QVector<QString> arr(n);
     for (int i = 0; i < n; ++i)
-        arr[i] = QString::number(seq.get(i));
+        arr[i] = QString::number(vals[i]);
 
     const qreal cellW  = 68;
     const qreal cellH  = 54;
@@ -275,10 +282,7 @@ void MainWindow::seqlistErase(){
 
     // 步骤 0：显示当前状态，高亮要删除的格子
     steps.push_back([=, this]() {
-    seq.clear();
-    for (int i = 0; i < n; ++i) {
-        seq.insert(i, arr[i].toInt());
-    }
+    seq.assign(vals.constData(), vals.constData() + n);
 
     view->resetScene();
     view->setTitle(QStringLiteral("顺序表：删除前（pos=%1）").arg(pos));
@@ -404,10 +408,48 @@ void MainWindow::seqlistClear() {
     seq.clear(); drawSeqlist(seq); showMessage(QStringLiteral("顺序表：已清空"));
 }
 
+void MainWindow::seqlistQuery(const QString& op, int arg) {
+    view->setCurrentFamily(QStringLiteral("seq"));
+    if (seq.size() == 0) {
+        drawSeqlist(seq);
+        showMessage(QStringLiteral("顺序表：当前为空，无法查询"));
+        return;
+    }
+
+    // 查询直接扫描连续存储（SIMD 内核），不逐个 get()
+    int hit = -1;
+    QString msg;
+    if (op == "find") {
+        hit = seq.find(arg);
+        msg = hit >= 0 ? QStringLiteral("顺序表：%1 首次出现在下标 %2").arg(arg).arg(hit)
+                       : QStringLiteral("顺序表：未找到 %1").arg(arg);
+    } else if (op == "count") {
+        hit = seq.find(arg);
+        msg = QStringLiteral("顺序表：%1 共出现 %2 次").arg(arg).arg(seq.count(arg));
+    } else if (op == "gt") {
+        hit = seq.find_if_greater(arg);
+        msg = hit >= 0 ? QStringLiteral("顺序表：第一个大于 %1 的元素是 %2（下标 %3）").arg(arg).arg(seq.get(hit)).arg(hit)
+                       : QStringLiteral("顺序表：没有大于 %1 的元素").arg(arg);
+    } else if (op == "min" || op == "max") {
+        int v = 0;
+        if (op == "min") seq.min(&v); else seq.max(&v);
+        hit = seq.find(v);
+        msg = QStringLiteral("顺序表：%1 = %2（下标 %3）").arg(op == "min" ? QStringLiteral("最小值") : QStringLiteral("最大值")).arg(v).arg(hit);
+    } else if (op == "sum") {
+        msg = QStringLiteral("顺序表：元素和 = %1").arg(seq.sum());
+    }
+
+    drawSeqlist(seq, hit);
+    view->setTitle(QStringLiteral("顺序表：查询 %1").arg(op));
+    showMessage(QStringLiteral("%1（%2，%3 个元素）").arg(msg, QString::fromLatin1(ds::simd::levelName(ds::simd::active()))).arg(seq.size()));
+}
+
 // ===== 链表 =====
 void MainWindow::linklistBuild()
 {
     auto a = parseIntList(linklistInput->text());
+    if (linkMode_ == LinkMode::Unrolled) { unrolledBuild(a); return; }
+    if (linkMode_ == LinkMode::Doubly) { dlinkBuild(a); return; }
 
     timer.stop();
     steps.clear();
@@ -441,13 +483,15 @@ void MainWindow::linklistInsert() {
     int pos = linklistPosition->value();
     bool ok = false; int v = linklistValue->text().toInt(&ok);
     if(!ok) { showMessage(QStringLiteral("链表：请输入有效的值")); return; }
+    if (linkMode_ == LinkMode::Unrolled) { unrolledInsert(pos, v); return; }
+    if (linkMode_ == LinkMode::Doubly) { dlinkInsert(pos, v); return; }
 
     int n = link.size();
     if (pos < 0) pos = 0; if (pos > n) pos = n;
 
     //把链表当前内容抽出来变成顺序数组
     QVector<int> vals; vals.reserve(n);
-    for (int i = 0; i < n; ++i) vals.push_back(link.get(i));
+    for (int x : link) vals.push_back(x);
 
     //计算绘制布局
     const qreal y = 220, dx = 120, startX = 150; // 增加startX，让链表整体右移
@@ -900,11 +944,13 @@ void MainWindow::linklistInsert() {
 
 void MainWindow::linklistErase() {
     int pos = linklistPosition->value();
+    if (linkMode_ == LinkMode::Unrolled) { unrolledErase(pos); return; }
+    if (linkMode_ == LinkMode::Doubly) { dlinkErase(pos); return; }
     int n = link.size();
     if (pos < 0 || pos >= n) { showMessage(QStringLiteral("链表：删除失败(位置越界)")); return; }
 
     QVector<int> vals; vals.reserve(n);
-    for (int i = 0; i < n; ++i) vals.push_back(link.get(i));
+    for (int x : link) vals.push_back(x);
 
     const qreal y = 220, dx = 120, startX = 120;
     QVector<QPointF> centers; centers.reserve(n);
@@ -1368,7 +1414,372 @@ void MainWindow::linklistErase() {
     timer.start();
 }
 
-void MainWindow::linklistClear() { link.clear(); drawLinklist(link); statusBar()->showMessage(QStringLiteral("链表：已清空")); }
+void MainWindow::linklistClear() {
+    link.clear(); ulink.clear(); dlink.clear();
+    drawCurrentLinklist();
+    statusBar()->showMessage(QStringLiteral("链表：已清空"));
+}
+
+// ===== 链表存储方式切换 =====
+// 切换存储方式时把现有内容原样搬到另一种结构里，画布保持同一份数据
+void MainWindow::setLinklistMode(LinkMode mode) {
+    const int idx = static_cast<int>(mode);
+    if (linklistMode && linklistMode->currentIndex() != idx) {
+        QSignalBlocker block(linklistMode);
+        linklistMode->setCurrentIndex(idx);
+    }
+    if (mode == linkMode_) return;
+
+    QVector<int> vals;
+    switch (linkMode_) {
+    case LinkMode::Node:     for (int x : link)  vals.push_back(x); link.clear();  break;
+    case LinkMode::Unrolled: for (int x : ulink) vals.push_back(x); ulink.clear(); break;
+    case LinkMode::Doubly:   for (int x : dlink) vals.push_back(x); dlink.clear(); break;
+    }
+    for (int x : vals) {
+        switch (mode) {
+        case LinkMode::Node:     link.push_back(x);  break;
+        case LinkMode::Unrolled: ulink.push_back(x); break;
+        case LinkMode::Doubly:   dlink.push_back(x); break;
+        }
+    }
+    linkMode_ = mode;
+
+    if (currentKind_ == DocKind::LinkedList) {
+        timer.stop(); steps.clear(); stepIndex = 0;
+        drawCurrentLinklist();
+    }
+    switch (mode) {
+    case LinkMode::Node:     showMessage(QStringLiteral("链表：切换为单结点存储")); break;
+    case LinkMode::Unrolled: showMessage(QStringLiteral("链表：切换为块状存储（每块 %1 个值）").arg(ulink.blockCapacity())); break;
+    case LinkMode::Doubly:   showMessage(QStringLiteral("链表：切换为双链表存储（prev/next 双向指针）")); break;
+    }
+}
+
+// 按当前存储方式重画链表
+void MainWindow::drawCurrentLinklist() {
+    switch (linkMode_) {
+    case LinkMode::Node:     drawLinklist(link);          break;
+    case LinkMode::Unrolled: drawUnrolledLinklist(ulink); break;
+    case LinkMode::Doubly:   drawDLinklist(dlink);        break;
+    }
+}
+
+// ===== 块状链表（链表页的另一种存储模式） =====
+void MainWindow::unrolledBuild(const QVector<int>& a) {
+    timer.stop(); steps.clear(); stepIndex = 0;
+    view->resetScene();
+    view->setTitle(QStringLiteral("块状链表：建立"));
+
+    // 第 0 步：从空表开始（重播时也会执行）
+    steps.push_back([this]() {
+        ulink.clear();
+        drawUnrolledLinklist(ulink);
+        view->setTitle(QStringLiteral("块状链表：建立"));
+        showMessage(QStringLiteral("块状链表：开始建立"));
+    });
+
+    for (int x : a) {
+        steps.push_back([this, x]() {
+            ulink.push_back(x);
+            drawUnrolledLinklist(ulink, ulink.size() - 1);
+            showMessage(QStringLiteral("块状链表：追加元素 %1（共 %2 块）").arg(x).arg(ulink.blockCount()));
+        });
+    }
+
+    timer.start();
+    updateAnimUiState();
+}
+
+// 块状链表按块的快照：动画步骤只画快照，不再从一串值重建链表（那样会把块重新排满，丢掉真实的块布局）
+static QVector<QVector<int>> unrolledSnapshot(const ds::UnrolledLinklist<>& ul) {
+    QVector<QVector<int>> blocks;
+    blocks.reserve(ul.blockCount());
+    for (const auto* b = ul.firstBlock(); b; b = b->next)
+        blocks.push_back(QVector<int>(b->values, b->values + b->count));
+    return blocks;
+}
+
+void MainWindow::unrolledInsert(int pos, int value) {
+    const int n = ulink.size();
+    if (pos < 0) pos = 0;
+    if (pos > n) pos = n;
+
+    // 真正的插入只做一次；前后两个状态都按块记下来，重播时只重画
+    const QVector<QVector<int>> before = unrolledSnapshot(ulink);
+    if (!ulink.insert(pos, value)) { showMessage(QStringLiteral("链表：插入失败(内存不足)")); return; }
+    const QVector<QVector<int>> after = unrolledSnapshot(ulink);
+    const bool split = after.size() > before.size();
+
+    timer.stop(); steps.clear(); stepIndex = 0;
+
+    // 第 1 步：插入前的块布局，高亮插入位置上的旧元素
+    steps.push_back([=, this]() {
+        drawUnrolledBlocks(before, pos < n ? pos : -1);
+        view->setTitle(QStringLiteral("块状链表：插入前（pos=%1）").arg(pos));
+        showMessage(QStringLiteral("块状链表：定位 pos=%1 所在的块").arg(pos));
+    });
+
+    // 第 2 步：只改动一块（满了先对半拆分）
+    steps.push_back([=, this]() {
+        drawUnrolledBlocks(after, pos);
+        view->setTitle(QStringLiteral("块状链表：插入完成（pos=%1, val=%2）").arg(pos).arg(value));
+        showMessage(split ? QStringLiteral("块状链表：目标块已满，拆分后插入 %1").arg(value)
+                             : QStringLiteral("块状链表：块内右移后插入 %1").arg(value));
+    });
+
+    timer.start();
+    updateAnimUiState();
+}
+
+void MainWindow::unrolledErase(int pos) {
+    const int n = ulink.size();
+    if (pos < 0 || pos >= n) { showMessage(QStringLiteral("链表：删除失败(位置越界)")); return; }
+
+    const int value = ulink.get(pos);
+    const QVector<QVector<int>> before = unrolledSnapshot(ulink);
+    ulink.erase(pos);
+    const QVector<QVector<int>> after = unrolledSnapshot(ulink);
+    const bool merged = after.size() < before.size();
+
+    timer.stop(); steps.clear(); stepIndex = 0;
+
+    steps.push_back([=, this]() {
+        drawUnrolledBlocks(before, pos);
+        view->setTitle(QStringLiteral("块状链表：删除前（pos=%1）").arg(pos));
+        showMessage(QStringLiteral("块状链表：定位要删除的元素 %1").arg(value));
+    });
+
+    steps.push_back([=, this]() {
+        drawUnrolledBlocks(after);
+        view->setTitle(QStringLiteral("块状链表：删除完成（pos=%1）").arg(pos));
+        showMessage(merged ? QStringLiteral("块状链表：删除后块过空，已与相邻块合并/回收")
+                           : QStringLiteral("块状链表：块内左移完成删除"));
+    });
+
+    timer.start();
+    updateAnimUiState();
+}
+
+// ===== 双链表（链表页的另一种存储模式） =====
+// 画布布局与 drawDLinklist 一致：第 i 个结点圆心在 (150 + i*130, 220)
+static QPointF dlinkCenter(int i) { return QPointF(150 + i * 130, 220); }
+
+void MainWindow::dlinkBuild(const QVector<int>& a) {
+    timer.stop(); steps.clear(); stepIndex = 0;
+    view->resetScene();
+    view->setTitle(QStringLiteral("双链表：建立"));
+
+    // 第 0 步：从空表开始（重播时也会执行）
+    steps.push_back([this]() {
+        dlink.clear();
+        drawDLinklist(dlink);
+        view->setTitle(QStringLiteral("双链表：建立"));
+        showMessage(QStringLiteral("双链表：开始建立"));
+    });
+
+    for (int x : a) {
+        steps.push_back([this, x]() {
+            dlink.push_back(x);
+            drawDLinklist(dlink, dlink.size() - 1);
+            showMessage(QStringLiteral("双链表：尾插 %1（s->prev = tail; tail->next = s; tail = s）").arg(x));
+        });
+    }
+
+    timer.start();
+    updateAnimUiState();
+}
+
+void MainWindow::dlinkInsert(int pos, int value) {
+    const int n = dlink.size();
+    if (pos < 0) pos = 0;
+    if (pos > n) pos = n;
+
+    QVector<int> vals; vals.reserve(n);
+    for (int x : dlink) vals.push_back(x);
+
+    // 中间位置与 DLinklist::nodeAt 一致：从较近的一端出发
+    const bool fromTail = !(pos < n - pos);
+    const int walk = (pos == 0 || pos == n) ? 0 : (fromTail ? n - 1 - pos : pos);
+    const int prevIndex = pos - 1, succIndex = (pos < n) ? pos : -1;
+
+    const qreal y = 220;
+    const QPointF s(qMax<qreal>(dlinkCenter(pos).x() - 65, 100), y + 150);
+
+    // 新结点 s 画在链表下方，stage 1 画 s 自己的两个指针，stage 2 再画前驱/后继指回 s
+    auto overlay = [=, this](int stage) {
+        view->addNode(s.x(), s.y(), QString::number(value), true);
+        auto* sLabel = view->Scene()->addText("s");
+        sLabel->setDefaultTextColor(QColor("#22c55e"));
+        sLabel->setFont(QFont("Arial", 14, QFont::Bold));
+        sLabel->setPos(s.x() - 8, s.y() + 38);
+
+        if (succIndex >= 0) {
+            const QPointF c = dlinkCenter(succIndex);
+            view->addEdge(QPointF(s.x() + 30, s.y() - 18), QPointF(c.x() - 8, y + 34));
+            if (stage >= 2) view->addEdge(QPointF(c.x() + 8, y + 34), QPointF(s.x() + 18, s.y() - 30));
+        }
+        if (prevIndex >= 0) {
+            const QPointF c = dlinkCenter(prevIndex);
+            view->addEdge(QPointF(s.x() - 30, s.y() - 18), QPointF(c.x() + 8, y + 34));
+            if (stage >= 2) view->addEdge(QPointF(c.x() - 8, y + 34), QPointF(s.x() - 18, s.y() - 30));
+        }
+        if (stage >= 2 && prevIndex < 0) view->addEdge(QPointF(60, y + 6), QPointF(s.x() - 34, s.y() - 8));
+        if (stage >= 2 && succIndex < 0) {
+            const qreal tx = dlinkCenter(n).x() - 40;
+            view->addEdge(QPointF(tx, y + 6), QPointF(s.x() + 34, s.y() - 8));
+        }
+    };
+
+    timer.stop(); steps.clear(); stepIndex = 0;
+
+    // 第 1 步：还原到插入前，定位后继结点 p
+    steps.push_back([=, this]() {
+        dlink.clear();
+        for (int x : vals) dlink.push_back(x);
+        drawDLinklist(dlink, succIndex);
+        view->setTitle(QStringLiteral("双链表：插入前（pos=%1）").arg(pos));
+        if (pos == 0)      showMessage(QStringLiteral("步骤1：头插，直接使用 head，无需遍历"));
+        else if (pos == n) showMessage(QStringLiteral("步骤1：尾插，直接使用 tail，无需遍历"));
+        else showMessage(QStringLiteral("步骤1：从 %1 出发走 %2 步定位 p（下标 %3）")
+                             .arg(fromTail ? QStringLiteral("tail") : QStringLiteral("head")).arg(walk).arg(pos));
+    });
+
+    // 第 2 步：先设置新结点自己的 prev/next
+    steps.push_back([=, this]() {
+        drawDLinklist(dlink, succIndex);
+        overlay(1);
+        view->setTitle(QStringLiteral("双链表：设置 s 的指针"));
+        if (pos == 0)      showMessage(QStringLiteral("步骤2：s->prev = NULL; s->next = head"));
+        else if (pos == n) showMessage(QStringLiteral("步骤2：s->prev = tail; s->next = NULL"));
+        else showMessage(QStringLiteral("步骤2：s->prev = p->prev; s->next = p"));
+    });
+
+    // 第 3 步：再让前驱的 next、后继的 prev 指向新结点
+    steps.push_back([=, this]() {
+        drawDLinklist(dlink, succIndex);
+        overlay(2);
+        view->setTitle(QStringLiteral("双链表：前驱/后继指向 s"));
+        if (n == 0)        showMessage(QStringLiteral("步骤3：head = tail = s"));
+        else if (pos == 0) showMessage(QStringLiteral("步骤3：head->prev = s; head = s"));
+        else if (pos == n) showMessage(QStringLiteral("步骤3：tail->next = s; tail = s"));
+        else showMessage(QStringLiteral("步骤3：p->prev->next = s; p->prev = s"));
+    });
+
+    steps.push_back([=, this]() {
+        dlink.insert(pos, value);
+        drawDLinklist(dlink, pos);
+        view->setTitle(QStringLiteral("双链表：插入完成（pos=%1, val=%2）").arg(pos).arg(value));
+        showMessage(QStringLiteral("双链表插入完成：insert(%1,%2)").arg(pos).arg(value));
+    });
+
+    timer.start();
+    updateAnimUiState();
+}
+
+void MainWindow::dlinkErase(int pos) {
+    const int n = dlink.size();
+    if (pos < 0 || pos >= n) { showMessage(QStringLiteral("链表：删除失败(位置越界)")); return; }
+
+    QVector<int> vals; vals.reserve(n);
+    for (int x : dlink) vals.push_back(x);
+
+    const bool fromTail = !(pos < n - pos);
+    const int walk = (pos == 0 || pos == n - 1) ? 0 : (fromTail ? n - 1 - pos : pos);
+    const qreal y = 220;
+
+    // stage 1：前驱的 next（或 head）越过 p；stage 2：后继的 prev（或 tail）越过 p
+    auto overlay = [=, this](int stage) {
+        auto* pLabel = view->Scene()->addText("p");
+        pLabel->setDefaultTextColor(QColor("#ef4444"));
+        pLabel->setFont(QFont("Arial", 14, QFont::Bold));
+        pLabel->setPos(dlinkCenter(pos).x() - 8, y - 72);
+
+        const QPointF from = (pos > 0) ? dlinkCenter(pos - 1) + QPointF(20, -30) : QPointF(60, y - 6);
+        const QPointF to   = (pos < n - 1) ? dlinkCenter(pos + 1) + QPointF(-20, -30) : QPointF();
+        if (pos < n - 1) {
+            view->addCurveArrow(from, from + QPointF(30, -90), to + QPointF(-30, -90), to);
+        }
+        if (stage >= 2 && pos > 0) {
+            const QPointF back = (pos < n - 1) ? dlinkCenter(pos + 1) + QPointF(-20, 30)
+                                               : QPointF(dlinkCenter(n).x() - 40, y + 6);
+            const QPointF dst = dlinkCenter(pos - 1) + QPointF(20, 30);
+            view->addCurveArrow(back, back + QPointF(-30, 90), dst + QPointF(30, 90), dst);
+        }
+    };
+
+    timer.stop(); steps.clear(); stepIndex = 0;
+
+    steps.push_back([=, this]() {
+        dlink.clear();
+        for (int x : vals) dlink.push_back(x);
+        drawDLinklist(dlink, pos);
+        view->setTitle(QStringLiteral("双链表：删除前（pos=%1）").arg(pos));
+        if (pos == 0)          showMessage(QStringLiteral("步骤1：删除头结点，p = head，O(1)"));
+        else if (pos == n - 1) showMessage(QStringLiteral("步骤1：删除尾结点，p = tail，O(1)（单链表需从头找前驱）"));
+        else showMessage(QStringLiteral("步骤1：从 %1 出发走 %2 步定位 p（下标 %3）")
+                             .arg(fromTail ? QStringLiteral("tail") : QStringLiteral("head")).arg(walk).arg(pos));
+    });
+
+    steps.push_back([=, this]() {
+        drawDLinklist(dlink, pos);
+        overlay(1);
+        view->setTitle(QStringLiteral("双链表：修改 next 方向"));
+        if (n == 1)        showMessage(QStringLiteral("步骤2：head = NULL"));
+        else if (pos == 0) showMessage(QStringLiteral("步骤2：head = p->next"));
+        else if (pos == n - 1) showMessage(QStringLiteral("步骤2：p->prev->next = NULL"));
+        else showMessage(QStringLiteral("步骤2：p->prev->next = p->next"));
+    });
+
+    steps.push_back([=, this]() {
+        drawDLinklist(dlink, pos);
+        overlay(2);
+        view->setTitle(QStringLiteral("双链表：修改 prev 方向"));
+        if (n == 1)            showMessage(QStringLiteral("步骤3：tail = NULL"));
+        else if (pos == n - 1) showMessage(QStringLiteral("步骤3：tail = p->prev"));
+        else if (pos == 0)     showMessage(QStringLiteral("步骤3：p->next->prev = NULL"));
+        else showMessage(QStringLiteral("步骤3：p->next->prev = p->prev"));
+    });
+
+    steps.push_back([=, this]() {
+        dlink.erase(pos);
+        drawDLinklist(dlink);
+        view->setTitle(QStringLiteral("双链表：删除完成"));
+        showMessage(QStringLiteral("链表：删除位置 %1 完成（free(p)）").arg(pos));
+    });
+
+    timer.start();
+    updateAnimUiState();
+}
+
+void MainWindow::dlinkGet(int pos) {
+    const int n = dlink.size();
+    if (pos < 0 || pos >= n) { showMessage(QStringLiteral("双链表：访问失败(位置越界)")); return; }
+
+    const bool fromTail = !(pos < n - pos);
+    const int walk = fromTail ? n - 1 - pos : pos;
+    const int value = dlink.get(pos);
+
+    timer.stop(); steps.clear(); stepIndex = 0;
+
+    for (int k = 0; k <= walk; ++k) {
+        const int i = fromTail ? n - 1 - k : k;
+        steps.push_back([=, this]() {
+            drawDLinklist(dlink, i);
+            view->setTitle(QStringLiteral("双链表：get(%1)").arg(pos));
+            showMessage(k == 0 ? QStringLiteral("双链表：p = %1（下标 %2）").arg(fromTail ? QStringLiteral("tail") : QStringLiteral("head")).arg(i)
+                               : QStringLiteral("双链表：p = p->%1（下标 %2）").arg(fromTail ? QStringLiteral("prev") : QStringLiteral("next")).arg(i));
+        });
+    }
+
+    steps.push_back([=, this]() {
+        showMessage(QStringLiteral("双链表：get(%1) = %2，从 %3 出发共走 %4 步（单链表需 %5 步）")
+                        .arg(pos).arg(value).arg(fromTail ? QStringLiteral("tail") : QStringLiteral("head")).arg(walk).arg(pos));
+    });
+
+    timer.start();
+    updateAnimUiState();
+}
 
 // ===== 栈 =====
 void MainWindow::stackBuild()
@@ -1592,13 +2003,7 @@ void MainWindow::btPreorder() {
     // 2) 前端再跑一遍先序，拿“结点指针序列”，因为动画需要用指针而不是节点序列
     QVector<ds::BTNode*> nodeOrder;
     nodeOrder.reserve(need);
-    std::function<void(ds::BTNode*)> dfs = [&](ds::BTNode* p){
-        if (!p) return;
-        nodeOrder.push_back(p);
-        dfs(p->left);
-        dfs(p->right);
-    };
-    dfs(bt.root());
+    ds::BinaryTree::preorderWalk(bt.root(), [&](ds::BTNode* p){ nodeOrder.push_back(p); });
 
     int m = qMin(n, nodeOrder.size());
 
@@ -1643,13 +2048,7 @@ void MainWindow::btInorder() {
     // 2) 结点指针序列（中序）
     QVector<ds::BTNode*> nodeOrder;
     nodeOrder.reserve(need);
-    std::function<void(ds::BTNode*)> dfs = [&](ds::BTNode* p){
-        if (!p) return;
-        dfs(p->left);
-        nodeOrder.push_back(p);
-        dfs(p->right);
-    };
-    dfs(bt.root());
+    ds::BinaryTree::inorderWalk(bt.root(), [&](ds::BTNode* p){ nodeOrder.push_back(p); });
 
     int m = qMin(n, nodeOrder.size());
 
@@ -1693,13 +2092,7 @@ void MainWindow::btPostorder() {
     // 2) 结点指针序列（后序）
     QVector<ds::BTNode*> nodeOrder;
     nodeOrder.reserve(need);
-    std::function<void(ds::BTNode*)> dfs = [&](ds::BTNode* p){
-        if (!p) return;
-        dfs(p->left);
-        dfs(p->right);
-        nodeOrder.push_back(p);
-    };
-    dfs(bt.root());
+    ds::BinaryTree::postorderWalk(bt.root(), [&](ds::BTNode* p){ nodeOrder.push_back(p); });
 
     int m = qMin(n, nodeOrder.size());
 
@@ -2038,10 +2431,7 @@ void MainWindow::bstErase() {
 
     // 步骤 0：每次播放（包括重播）都先把 BST 精确还原到“删除前”的状态
     steps.push_back([this, value, preorderKeys]() {
-        bst.clear();
-        for (int k : preorderKeys) {
-            bst.insert(k);
-        }
+        bst.bulkLoad(preorderKeys.data(), preorderKeys.size(), ds::BinarySearchTree::LoadMode::InsertionOrder);
 
         view->resetScene();
         view->setTitle(QStringLiteral("BST 删除 %1：查找目标（开始）").arg(value));
@@ -2054,10 +2444,7 @@ void MainWindow::bstErase() {
         int keyOnPath = pathKeys[i];
         steps.push_back([this, value, keyOnPath, i, pathKeys, preorderKeys]() {
             // 为了避免上一次播放遗留的结构，这里也强制还原一遍“删除前”的树
-            bst.clear();
-            for (int k : preorderKeys) {
-                bst.insert(k);
-            }
+            bst.bulkLoad(preorderKeys.data(), preorderKeys.size(), ds::BinarySearchTree::LoadMode::InsertionOrder);
 
             // 模拟搜索过程：从根一路查找，直到 keyOnPath
             ds::BTNode* cur = bst.root();
@@ -2085,10 +2472,7 @@ void MainWindow::bstErase() {
     // 最后一步：在“删除前”的树上真正执行删除，并重绘结果
     steps.push_back([this, value, preorderKeys]() {
         // 先还原“删除前”的整棵树
-        bst.clear();
-        for (int k : preorderKeys) {
-            bst.insert(k);
-        }
+        bst.bulkLoad(preorderKeys.data(), preorderKeys.size(), ds::BinarySearchTree::LoadMode::InsertionOrder);
 
         // 再真正执行一次删除
         bst.eraseKey(value);
@@ -2105,26 +2489,105 @@ void MainWindow::bstErase() {
 
 
 
-void MainWindow::bstClear() { bst.clear(); view->resetScene(); view->setTitle(QStringLiteral("BST（空）")); }
+void MainWindow::bstBalance() {
+    QVector<int> preorderKeys;
+    dumpPreorder(bst.root(), preorderKeys);
+    const int h0 = bst.height();
 
-// ===== 哈夫曼树（含合并动画） =====
-void MainWindow::huffmanBuild() {
-    auto w = parseIntList(huffmanInput->text());
-    if (w.isEmpty()) {
+    timer.stop();
+    steps.clear();
+    stepIndex = 0;
+
+    // 步骤 0：平衡前（重播时按先序序列原样还原）
+    steps.push_back([this, preorderKeys, h0]() {
+        bst.bulkLoad(preorderKeys.data(), preorderKeys.size(), ds::BinarySearchTree::LoadMode::InsertionOrder);
         view->resetScene();
-        view->setTitle(QStringLiteral("哈夫曼树：请输入权值序列"));
-        showMessage(QStringLiteral("哈夫曼树：无有效输入"));
+        view->setTitle(QStringLiteral("BST 平衡化：平衡前（高度 %1）").arg(h0));
+        drawBT(bst.root(), 400, 120, 200, 0);
+        showMessage(QStringLiteral("BST 平衡化：先右旋拉成一条右链，再分轮左旋压成完全平衡的树"));
+    });
+
+    // 步骤 1：原地 DSW 平衡
+    steps.push_back([this, h0]() {
+        bst.balance();
+        view->resetScene();
+        view->setTitle(QStringLiteral("BST 平衡化：完成（高度 %1 → %2）").arg(h0).arg(bst.height()));
+        drawBT(bst.root(), 400, 120, 200, 0);
+        showMessage(QStringLiteral("BST 平衡化完成：%1 个结点，高度 %2").arg(bst.count()).arg(bst.height()));
+    });
+
+    timer.start();
+    updateAnimUiState();
+}
+
+// 第 k 小：每到一个结点比较 k 与左子树大小，决定向左、命中还是减掉左子树和自己后向右
+void MainWindow::bstKth() {
+    bool ok = false;
+    const int k = bstValue->text().toInt(&ok);
+    if (!ok) {
+        showMessage(QStringLiteral("二叉搜索树：请输入有效的 k"));
         return;
     }
 
-    // 记录最后一次权值序列，便于保存/恢复
-    huffLastWeights_ = w;
+    struct Visit { ds::BTNode* node; int k; };  // 到达结点时剩余的 k
+    QVector<Visit> path;
+    int rest = k;
+    ds::BTNode* hit = bst.select(k, [&](ds::BTNode* p) {
+        path.push_back({p, rest});
+        const int ls = p->left ? p->left->size : 0;
+        if (rest > ls + 1) rest -= ls + 1;
+    });
+    const int n = bst.count();
 
-    huff.clear();
     timer.stop();
     steps.clear();
     stepIndex = 0;
 
+    for (int i = 0; i < path.size(); ++i) {
+        const Visit v = path[i];
+        steps.push_back([this, i, v, k, total = path.size()]() {
+            const int ls = v.node->left ? v.node->left->size : 0;
+            view->resetScene();
+            view->setTitle(QStringLiteral("BST 第 %1 小（%2/%3）").arg(k).arg(i + 1).arg(total));
+            g_btHighlightNode = v.node;
+            drawBT(bst.root(), 400, 120, 200, 0);
+            g_btHighlightNode = nullptr;
+
+            QString how;
+            if (v.k <= ls) how = QStringLiteral("向左");
+            else if (v.k == ls + 1) how = QStringLiteral("命中");
+            else how = QStringLiteral("向右找第 %1 小").arg(v.k - ls - 1);
+            showMessage(QStringLiteral("BST 第 k 小：结点 %1，左子树 %2 个，k = %3，%4")
+                            .arg(v.node->key).arg(ls).arg(v.k).arg(how));
+        });
+    }
+
+    steps.push_back([this, k, n, hit]() {
+        view->resetScene();
+        g_btHighlightNode = hit;
+        drawBT(bst.root(), 400, 120, 200, 0);
+        g_btHighlightNode = nullptr;
+        if (hit) {
+            view->setTitle(QStringLiteral("BST 第 %1 小：%2").arg(k).arg(hit->key));
+            showMessage(QStringLiteral("BST 第 %1 小为 %2").arg(k).arg(hit->key));
+        } else {
+            view->setTitle(QStringLiteral("BST 第 %1 小：不存在（共 %2 个结点）").arg(k).arg(n));
+            showMessage(QStringLiteral("BST 第 k 小：k 应在 1..%1 之间").arg(n));
+        }
+    });
+
+    timer.start();
+    updateAnimUiState();
+}
+
+void MainWindow::bstClear() { bst.clear(); view->resetScene(); view->setTitle(QStringLiteral("BST（空）")); }
+
+// ===== 哈夫曼树（含合并动画） =====
+// 画哈夫曼树：边上标 0/1，annotateCodes 时在叶子上方标出码字
+void MainWindow::drawHuffmanTree(ds::BTNode* n, qreal x, qreal y, qreal dist, const QString& prefix, bool annotateCodes) {
+    if (!n) return;
+    const qreal R = 34;
+
     //给边添加 “0/1” 标签
     auto addEdgeLabel = [this](const QPointF& a, const QPointF& b, const QString& text, qreal offset = 12.0) {
         QPointF mid((a.x() + b.x()) / 2.0, (a.y() + b.y()) / 2.0);
@@ -2142,42 +2605,38 @@ void MainWindow::huffmanBuild() {
         t->setPos(pos.x() - tb.width() / 2.0, pos.y() - tb.height() / 2.0);
     };
 
-    const qreal R = 34;
-    using DrawFn = std::function<void(ds::BTNode*, qreal, qreal, qreal, const QString&, bool)>;
-    auto drawHuffTree = std::make_shared<DrawFn>();
-    //递归画图函数
-    *drawHuffTree = [this, drawHuffTree, addEdgeLabel, R](ds::BTNode* n, qreal x, qreal y, qreal dist, const QString& prefix, bool annotateCodes) {
-        if (!n) return;
-        bool isLeaf = (!n->left && !n->right);//叶子
+    bool isLeaf = (!n->left && !n->right);//叶子
 
-        // 叶结点高亮，内部结点普通（颜色由 Canvas::addNode 控制）
-        view->addNode(x, y, QString::number(n->key), isLeaf);
+    // 叶结点高亮，内部结点普通（颜色由 Canvas::addNode 控制）
+    view->addNode(x, y, QString::number(n->key), isLeaf);
 
-        if (n->left) {
-            qreal lx = x - dist, ly = y + 100;
-            QPointF a(x, y + R), b(lx, ly - R);
-            view->addEdge(a, b);
-            addEdgeLabel(a, b, "0", 12.0);
-            (*drawHuffTree)(n->left, lx, ly, dist / 1.8, prefix + "0", annotateCodes);
-        }
-        if (n->right) {
-            qreal rx = x + dist, ry = y + 100;
-            QPointF a(x, y + R), b(rx, ry - R);
-            view->addEdge(a, b);
-            addEdgeLabel(a, b, "1", 12.0);
-            (*drawHuffTree)(n->right, rx, ry, dist / 1.8, prefix + "1", annotateCodes);
-        }
+    if (n->left) {
+        qreal lx = x - dist, ly = y + 100;
+        QPointF a(x, y + R), b(lx, ly - R);
+        view->addEdge(a, b);
+        addEdgeLabel(a, b, "0", 12.0);
+        drawHuffmanTree(n->left, lx, ly, dist / 1.8, prefix + "0", annotateCodes);
+    }
+    if (n->right) {
+        qreal rx = x + dist, ry = y + 100;
+        QPointF a(x, y + R), b(rx, ry - R);
+        view->addEdge(a, b);
+        addEdgeLabel(a, b, "1", 12.0);
+        drawHuffmanTree(n->right, rx, ry, dist / 1.8, prefix + "1", annotateCodes);
+    }
 
-        // 叶子上方标出码字
-        if (annotateCodes && isLeaf) {
-            QString code = prefix.isEmpty() ? QString("0") : prefix;
-            auto* t = view->Scene()->addText(code);
-            t->setDefaultTextColor(QColor("#065f46"));
-            QRectF tb = t->boundingRect();
-            t->setPos(x - tb.width() / 2.0, y - R - 12 - tb.height());
-        }
-    };
+    // 叶子上方标出码字
+    if (annotateCodes && isLeaf) {
+        QString code = prefix.isEmpty() ? QString("0") : prefix;
+        auto* t = view->Scene()->addText(code);
+        t->setDefaultTextColor(QColor("#065f46"));
+        QRectF tb = t->boundingRect();
+        t->setPos(x - tb.width() / 2.0, y - R - 12 - tb.height());
+    }
+}
 
+// 右侧编码表：列出树中每个叶子的 (权值, 编码)
+void MainWindow::fillHuffmanCodeTable(ds::BTNode* root) {
     // 小工具：从已构建好的 Huffman 树中收集所有叶子的 (权值, 编码)
     using CodePair = QPair<int, QString>;
     auto collectCodes = [](ds::BTNode* n, const QString& prefix, QVector<CodePair>& out, auto&& self) -> void {
@@ -2192,23 +2651,83 @@ void MainWindow::huffmanBuild() {
         self(n->right, prefix + "1", out, self);
     };
 
-    QVector<ds::BTNode*> forest;
-    forest.reserve(w.size());
-    for (int x : w) forest.push_back(ds::Huffman::makeNode(x));//对每个权值创建一个独立节点（单节点树），作为 Huffman 合并的起点
+    if (huffmanCodeTable) {
+        huffmanCodeTable->setRowCount(0);
 
-    //森林静态布局
-    auto drawForestFixed = [=, this](const QVector<ds::BTNode*>& F, const QString& title) {
-        view->resetScene();
-        view->setTitle(title);
-        qreal x = 150;
-        for (int i = 0; i < F.size(); ++i) {
-            (*drawHuffTree)(F[i], x, 120, 60, "", false);
-            x += 180;
-        }
-    };
+        QVector<CodePair> codes;
+        collectCodes(root, "", codes, collectCodes);
 
-    //两棵最小树“向中间移动”的补间动画
-    auto tweenTwo = [=, this](const QVector<ds::BTNode*>& F, int i1, int i2, qreal t, const QString& title) {
+        // 为了展示更整齐：按权值从小到大排序，同权值按码长排序
+        std::sort(codes.begin(), codes.end(), [](const CodePair& a, const CodePair& b) {
+            if (a.first != b.first) return a.first < b.first;
+            return a.second.length() < b.second.length();
+        });
+
+        huffmanCodeTable->setRowCount(codes.size());
+        for (int i = 0; i < codes.size(); ++i) {
+            const int wVal = codes[i].first;
+            const QString code = codes[i].second;
+
+            auto* itemIdx = new QTableWidgetItem(QString::number(i + 1));
+            itemIdx->setTextAlignment(Qt::AlignCenter);
+
+            auto* itemW = new QTableWidgetItem(QString::number(wVal));
+            itemW->setTextAlignment(Qt::AlignCenter);
+
+            auto* itemCode = new QTableWidgetItem(code);
+            itemCode->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
+
+            huffmanCodeTable->setItem(i, 0, itemIdx);
+            huffmanCodeTable->setItem(i, 1, itemW);
+            huffmanCodeTable->setItem(i, 2, itemCode);
+        }
+    }
+}
+
+void MainWindow::huffmanBuild() {
+    auto w = parseIntList(huffmanInput->text());
+    if (w.isEmpty()) {
+        view->resetScene();
+        view->setTitle(QStringLiteral("哈夫曼树：请输入权值序列"));
+        showMessage(QStringLiteral("哈夫曼树：无有效输入"));
+        return;
+    }
+
+    // 记录最后一次权值序列，便于保存/恢复
+    huffLastWeights_ = w;
+
+    huff.clear();
+    timer.stop();
+    steps.clear();
+    stepIndex = 0;
+
+    // 与 ds::Huffman 共用堆 / 双队列建树，只把合并顺序记下来，再按顺序生成动画
+    struct Merge { ds::BTNode* left; ds::BTNode* right; ds::BTNode* parent; };
+    QVector<Merge> merges;
+    merges.reserve(w.size());
+    QVector<ds::BTNode*> forest(w.size());  // 初始森林：每个权值一棵单结点树，顺序与输入相同
+    ds::BTNode* root = huff.buildTree(w.data(), w.size(), forest.data(),
+                                      [&merges](ds::BTNode* l, ds::BTNode* r, ds::BTNode* p) {
+                                          merges.push_back({l, r, p});
+                                      });
+    if (!root) {
+        showMessage(QStringLiteral("哈夫曼树：内存不足"));
+        return;
+    }
+
+    //森林静态布局
+    auto drawForestFixed = [=, this](const QVector<ds::BTNode*>& F, const QString& title) {
+        view->resetScene();
+        view->setTitle(title);
+        qreal x = 150;
+        for (int i = 0; i < F.size(); ++i) {
+            drawHuffmanTree(F[i], x, 120, 60, "", false);
+            x += 180;
+        }
+    };
+
+    //两棵最小树“向中间移动”的补间动画
+    auto tweenTwo = [=, this](const QVector<ds::BTNode*>& F, int i1, int i2, qreal t, const QString& title) {
         view->resetScene();
         view->setTitle(title);
         QVector<qreal> xs(F.size());
@@ -2223,7 +2742,7 @@ void MainWindow::huffmanBuild() {
             qreal x = xs[i];
             if (i == i1) x = xi1;
             if (i == i2) x = xi2;
-            (*drawHuffTree)(F[i], x, 120, 60, "", false);
+            drawHuffmanTree(F[i], x, 120, 60, "", false);
         }
     };
 
@@ -2236,27 +2755,18 @@ void MainWindow::huffmanBuild() {
     const int tweenFrames = 8;
     const int tweenInterval = qMax(15, timer.interval() / 7);
 
-    // 逐步合并两棵最小树，加入动画
-    while (cur.size() > 1) {//只要森林里还多于 1 棵树，就继续合并
-        int i1 = -1, i2 = -1;
-        //选择最小两棵
-        for (int i = 0; i < cur.size(); ++i)
-            if (i1 == -1 || cur[i]->key < cur[i1]->key) i1 = i;
-        for (int i = 0; i < cur.size(); ++i)
-            if (i != i1 && (i2 == -1 || cur[i]->key < cur[i2]->key)) i2 = i;
-        if (i1 > i2) std::swap(i1, i2);
-
-        //生成父节点，其左右孩子指向两棵最小树
-        int a = cur[i1]->key, b = cur[i2]->key;
-        ds::BTNode* parent = ds::Huffman::makeNode(a + b);
-        parent->left = cur[i1];
-        parent->right = cur[i2];
-
-        //合并前的快照
+    // 按建树时的合并顺序逐步播放：i1 为左孩子（较小的一棵）在森林中的位置，i2 为右孩子
+    for (const Merge& m : merges) {
+        const int i1 = cur.indexOf(m.left), i2 = cur.indexOf(m.right);
+        const int lo = qMin(i1, i2), hi = qMax(i1, i2);
+        const int a = m.left->key, b = m.right->key;
+        ds::BTNode* parent = m.parent;
+
+        //合并前的快照；合并后父结点占靠前的位置
         QVector<ds::BTNode*> before = cur;
         QVector<ds::BTNode*> after = cur;
-        after[i1] = parent;
-        after.remove(i2);
+        after[lo] = parent;
+        after.remove(hi);
 
         //插入一步：把合并前森林画出来，并在标题里强调当前选中哪两个最小权值
         steps.push_back([=, this]() {
@@ -2278,18 +2788,18 @@ void MainWindow::huffmanBuild() {
             onAnimSpeedChanged(animSpeedSlider->value());
         });
 
-        //真正更新当前森林：用父节点替换 i1，并删除 i2
-        cur[i1] = parent;
-        cur.remove(i2);
+        //更新当前森林：用父节点替换靠前的一棵，并删除另一棵
+        cur[lo] = parent;
+        cur.remove(hi);
     }
 
-    if (!cur.isEmpty()) huff.rootNode = cur[0];
+    huff.rootNode = root;
 
     // 最终：整棵树 + 叶子码字 + 右侧编码表
     steps.push_back([=, this]() {
         view->resetScene();
         view->setTitle(QStringLiteral("哈夫曼树：构建完成（边标 0/1；叶子上方显示码字）"));
-        (*drawHuffTree)(huff.root(), 400, 120, 200, "", true);
+        drawHuffmanTree(huff.root(), 400, 120, 200, "", true);
 
         auto* legend = view->Scene()->addText(
             QStringLiteral("图例：黄色=原始叶结点   蓝绿色=内部结点（合并产生）"));
@@ -2297,37 +2807,7 @@ void MainWindow::huffmanBuild() {
         legend->setPos(16, 54);
 
         // ===== 同步更新右侧编码表 =====
-        if (huffmanCodeTable) {
-            huffmanCodeTable->setRowCount(0);
-
-            QVector<CodePair> codes;
-            collectCodes(huff.root(), "", codes, collectCodes);
-
-            // 为了展示更整齐：按权值从小到大排序，同权值按码长排序
-            std::sort(codes.begin(), codes.end(), [](const CodePair& a, const CodePair& b) {
-                if (a.first != b.first) return a.first < b.first;
-                return a.second.length() < b.second.length();
-            });
-
-            huffmanCodeTable->setRowCount(codes.size());
-            for (int i = 0; i < codes.size(); ++i) {
-                const int wVal = codes[i].first;
-                const QString code = codes[i].second;
-
-                auto* itemIdx = new QTableWidgetItem(QString::number(i + 1));
-                itemIdx->setTextAlignment(Qt::AlignCenter);
-
-                auto* itemW = new QTableWidgetItem(QString::number(wVal));
-                itemW->setTextAlignment(Qt::AlignCenter);
-
-                auto* itemCode = new QTableWidgetItem(code);
-                itemCode->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-
-                huffmanCodeTable->setItem(i, 0, itemIdx);
-                huffmanCodeTable->setItem(i, 1, itemW);
-                huffmanCodeTable->setItem(i, 2, itemCode);
-            }
-        }
+        fillHuffmanCodeTable(huff.root());
 
         showMessage(QStringLiteral("哈夫曼树：完成"));
     });
@@ -2351,6 +2831,175 @@ void MainWindow::huffmanClear() {
     statusBar()->showMessage(QStringLiteral("哈夫曼树：已清空"));
 }
 
+// 限长哈夫曼码：package-merge 求出最长不超过 L 的最优码长，按范式码建树画出，并与不限长的哈夫曼码比较
+void MainWindow::huffmanLimit() {
+    auto w = parseIntList(huffmanInput->text());
+    const int n = w.size();
+    const int maxLen = huffmanMaxLen ? huffmanMaxLen->value() : 0;
+    if (w.isEmpty()) {
+        showMessage(QStringLiteral("限长哈夫曼码：请先输入权值序列"));
+        return;
+    }
+    for (int x : w) {
+        if (x <= 0) {
+            showMessage(QStringLiteral("限长哈夫曼码：权值必须为正数"));
+            return;
+        }
+    }
+
+    QVector<int> full(n), limited(n);
+    if (!ds::Huffman::codeLengths(w.data(), n, full.data())) {
+        showMessage(QStringLiteral("限长哈夫曼码：内存不足"));
+        return;
+    }
+    if (!ds::Huffman::limitedCodeLengths(w.data(), n, maxLen, limited.data())) {
+        showMessage(QStringLiteral("限长哈夫曼码：%1 个权值至少需要码长 %2（2^L >= n）")
+                        .arg(n).arg(int(std::ceil(std::log2(double(n))))));
+        return;
+    }
+
+    timer.stop();
+    steps.clear();
+    stepIndex = 0;
+    huff.clear();  // 新树的结点取自 huff 自己的结点池
+    ds::BTNode* root = huff.canonicalTree(w.data(), limited.data(), n);
+    if (!root) {
+        showMessage(QStringLiteral("限长哈夫曼码：内存不足"));
+        return;
+    }
+    huffLastWeights_ = w;
+    huff.rootNode = root;
+
+    qint64 total = 0, costFull = 0, costLimited = 0;
+    int deepFull = 0, deepLimited = 0;
+    for (int i = 0; i < n; ++i) {
+        total += w[i];
+        costFull += qint64(w[i]) * full[i];
+        costLimited += qint64(w[i]) * limited[i];
+        deepFull = qMax(deepFull, full[i]);
+        deepLimited = qMax(deepLimited, limited[i]);
+    }
+    const double loss = costFull > 0 ? 100.0 * double(costLimited - costFull) / double(costFull) : 0.0;
+
+    view->resetScene();
+    view->setTitle(QStringLiteral("限长哈夫曼码：最大码长 %1（范式码，边标 0/1；叶子上方显示码字）").arg(maxLen));
+    drawHuffmanTree(huff.root(), 400, 160, 200, "", true);
+    const QStringList lines = {
+        QStringLiteral("不限长：最长 %1 位，带权路径长度 %2，平均 %3 位").arg(deepFull).arg(costFull).arg(double(costFull) / total, 0, 'f', 3),
+        QStringLiteral("限长：  最长 %1 位，带权路径长度 %2，平均 %3 位").arg(deepLimited).arg(costLimited).arg(double(costLimited) / total, 0, 'f', 3),
+        QStringLiteral("压缩损失：+%1（+%2%）").arg(costLimited - costFull).arg(loss, 0, 'f', 2),
+    };
+    qreal y = 40;
+    for (const QString& line : lines) {
+        auto* t = view->Scene()->addText(line);
+        t->setDefaultTextColor(QColor("#444"));
+        t->setPos(16, y);
+        y += 22;
+    }
+    fillHuffmanCodeTable(huff.root());
+
+    showMessage(QStringLiteral("限长哈夫曼码：最长 %1 -> %2 位，压缩损失 %3%")
+                    .arg(deepFull).arg(deepLimited).arg(loss, 0, 'f', 2));
+}
+
+// 用 ds::HuffmanCodec 压缩一个文件：写出 <file>.huf，再解压校验，报告压缩率与两个方向的吞吐
+void MainWindow::huffmanEncodeFile(const QString& path) {
+    timer.stop();
+    steps.clear();
+    stepIndex = 0;
+
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        showMessage(QStringLiteral("哈夫曼编码：无法打开文件 %1").arg(path));
+        return;
+    }
+    const QByteArray raw = f.readAll();
+    f.close();
+    const auto* data = reinterpret_cast<const std::uint8_t*>(raw.constData());
+    const std::size_t n = static_cast<std::size_t>(raw.size());
+
+    std::uint64_t freq[ds::HuffmanCodec::kSymbols];
+    ds::HuffmanCodec::countBytes(data, n, freq);
+    ds::HuffmanCodec codec;
+    if (n > 0) codec.build(freq);
+
+    QElapsedTimer clock;
+    clock.start();
+    std::vector<std::uint8_t> packed;
+    const bool packedOk = ds::HuffmanCodec::compress(data, n, packed);
+    const qint64 encNs = clock.nsecsElapsed();
+    clock.restart();
+    std::vector<std::uint8_t> unpacked;
+    const bool unpackedOk = packedOk && ds::HuffmanCodec::decompress(packed.data(), packed.size(), unpacked);
+    const qint64 decNs = clock.nsecsElapsed();
+    if (!packedOk || !unpackedOk || unpacked.size() != n
+        || (n > 0 && std::memcmp(unpacked.data(), data, n) != 0)) {
+        showMessage(QStringLiteral("哈夫曼编码：压缩或校验失败"));
+        return;
+    }
+
+    const QString outPath = path + QStringLiteral(".huf");
+    QFile o(outPath);
+    const bool saved = o.open(QIODevice::WriteOnly)
+        && o.write(reinterpret_cast<const char*>(packed.data()), qint64(packed.size())) == qint64(packed.size());
+    o.close();
+
+    auto mbps = [n](qint64 ns) { return ns > 0 ? double(n) / 1e6 / (double(ns) / 1e9) : 0.0; };
+    const double ratio = n > 0 ? 100.0 * double(packed.size()) / double(n) : 0.0;
+    const double bitsPerByte = n > 0 ? double(codec.encodedBits(freq)) / double(n) : 0.0;
+
+    // 画布：只列结果，256 个叶子的树画出来看不清
+    view->resetScene();
+    view->setTitle(QStringLiteral("哈夫曼编码：%1").arg(QFileInfo(path).fileName()));
+    const QStringList lines = {
+        QStringLiteral("原始大小：%1 字节").arg(n),
+        QStringLiteral("压缩后：%1 字节（含 %2 字节数据头），%3%").arg(packed.size()).arg(ds::HuffmanCodec::kHeaderBytes).arg(ratio, 0, 'f', 1),
+        QStringLiteral("平均码长：%1 位/字节，最长码 %2 位").arg(bitsPerByte, 0, 'f', 3).arg(codec.maxLength()),
+        QStringLiteral("编码：%1 MB/s    解码：%2 MB/s（解码结果已与原文件逐字节比对）").arg(mbps(encNs), 0, 'f', 1).arg(mbps(decNs), 0, 'f', 1),
+        saved ? QStringLiteral("已写出：%1").arg(outPath) : QStringLiteral("写出失败：%1").arg(outPath),
+    };
+    qreal y = 80;
+    for (const QString& line : lines) {
+        auto* t = view->Scene()->addText(line);
+        t->setDefaultTextColor(QColor("#111"));
+        t->setPos(40, y);
+        y += 28;
+    }
+
+    // 右侧编码表：按出现次数从多到少列出每个字节的范式码
+    if (huffmanCodeTable) {
+        QVector<int> syms;
+        for (int s = 0; s < ds::HuffmanCodec::kSymbols; ++s)
+            if (freq[s]) syms.push_back(s);
+        std::sort(syms.begin(), syms.end(), [&freq](int a, int b) {
+            return freq[a] != freq[b] ? freq[a] > freq[b] : a < b;
+        });
+        huffmanCodeTable->setRowCount(syms.size());
+        for (int i = 0; i < syms.size(); ++i) {
+            const int s = syms[i];
+            const int len = codec.length(s);
+            QString code;
+            for (int k = len - 1; k >= 0; --k) code += ((codec.code(s) >> k) & 1) ? '1' : '0';
+            const QString label = (s >= 0x20 && s < 0x7F)
+                ? QStringLiteral("'%1'").arg(QChar(s))
+                : QStringLiteral("0x%1").arg(s, 2, 16, QChar('0'));
+
+            auto* itemIdx = new QTableWidgetItem(QString::number(i + 1));
+            itemIdx->setTextAlignment(Qt::AlignCenter);
+            auto* itemW = new QTableWidgetItem(QString::number(freq[s]));
+            itemW->setTextAlignment(Qt::AlignCenter);
+            auto* itemCode = new QTableWidgetItem(QStringLiteral("%1  %2").arg(label, code));
+            itemCode->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
+
+            huffmanCodeTable->setItem(i, 0, itemIdx);
+            huffmanCodeTable->setItem(i, 1, itemW);
+            huffmanCodeTable->setItem(i, 2, itemCode);
+        }
+    }
+
+    showMessage(QStringLiteral("哈夫曼编码：%1 -> %2 字节（%3%）").arg(n).arg(packed.size()).arg(ratio, 0, 'f', 1));
+}
+
 // ===== AVL树 =====
 void MainWindow::avlBuild() {
     auto a = parseIntList(avlInput->text());
@@ -2359,24 +3008,26 @@ void MainWindow::avlBuild() {
     steps.clear();
     stepIndex = 0;
 
-    // 第 0 步：清空 + 开始构建
+    // 第 0 步：开始构建（空树）
     steps.push_back([this]() {
-        avl.clear();
         view->resetScene();
         view->setTitle(QStringLiteral("AVL树：开始构建"));
-        drawBT(avl.root(), 400, 120, 200, 0);
         showMessage(QStringLiteral("AVL树：开始构建"));
     });
 
+    // 每次插入得到一个新版本（只复制 O(log n) 个结点），动画步骤持有前后两个版本，准备阶段总共 O(n log n)
+    avlHistory.clear();
+    ds::PersistentAVL::Version cur = nullptr;
     const int total = a.size();
-    QVector<int> built; built.reserve(total);
-
     for (int i = 0; i < total; ++i) {
         const int v = a[i];
+        ds::PersistentAVL::Version next = avlHistory.insert(cur, v);
+        if (!next) break;  // 结点申请失败
         // 这里“等价于调用 avlInsert 的核心动画逻辑”，但不会清空 steps
-        drawAVL(v, built, i, total);
-        built.push_back(v);
+        drawAVL(v, cur, next, avlHistory.rotationRecords(), i, total);
+        cur = next;
     }
+    avl.assign(cur);
 
     timer.start();
     updateAnimUiState();
@@ -2391,23 +3042,109 @@ void MainWindow::avlInsert() {
         return;
     }
 
-    // 新增：记录“插入前”的整棵树（先序遍历的键序列）
-    QVector<int> preorderKeys;
-    dumpPreorder(avl.root(), preorderKeys);
+    // 插入前后各取一个版本交给动画，avl 本身直接插入
+    avlHistory.clear();
+    ds::PersistentAVL::Version before = avlHistory.adopt(avl.root());
+    ds::PersistentAVL::Version after = avlHistory.insert(before, value);
+    avl.insert(value);
+
+    timer.stop();
+    steps.clear();
+    stepIndex = 0;
+
+    drawAVL(value, before, after, avlHistory.rotationRecords(), -1, -1);
+
+    timer.start();
+    updateAnimUiState();
+}
+
+
+void MainWindow::avlErase() {
+    bool ok = false;
+    int value = avlValue->text().toInt(&ok);
+    if (!ok) {
+        showMessage(QStringLiteral("AVL树：请输入有效的键值"));
+        return;
+    }
+
+    // 删除前后各取一个版本交给动画，avl 本身直接删除
+    avlHistory.clear();
+    ds::PersistentAVL::Version before = avlHistory.adopt(avl.root());
+    avl.erase(value);
+    ds::PersistentAVL::Version after = avlHistory.adopt(avl.root());
 
     timer.stop();
     steps.clear();
     stepIndex = 0;
 
-    drawAVL(value, preorderKeys, -1, -1);
+    drawAVLErase(value, before, after, avl.rotationRecords());
 
     timer.start();
     updateAnimUiState();
 }
 
 
+// 排名：向右走时把左子树和当前结点都计入“比 x 小”的个数
+void MainWindow::avlRank() {
+    bool ok = false;
+    const int value = avlValue->text().toInt(&ok);
+    if (!ok) {
+        showMessage(QStringLiteral("AVL树：请输入有效的键值"));
+        return;
+    }
+
+    struct Visit { ds::BTNode* node; int below; };  // 到达结点时已数出的比 value 小的键数
+    QVector<Visit> path;
+    int below = 0;
+    const int r = avl.rank(value, [&](ds::BTNode* p) {
+        path.push_back({p, below});
+        if (value > p->key) below += (p->left ? p->left->size : 0) + 1;
+    });
+    ds::BTNode* hit = (!path.isEmpty() && path.last().node->key == value) ? path.last().node : nullptr;
+
+    timer.stop();
+    steps.clear();
+    stepIndex = 0;
+
+    for (int i = 0; i < path.size(); ++i) {
+        const Visit v = path[i];
+        steps.push_back([this, i, v, value, total = path.size()]() {
+            const int ls = v.node->left ? v.node->left->size : 0;
+            view->resetScene();
+            view->setTitle(QStringLiteral("AVL 排名 %1（%2/%3）").arg(value).arg(i + 1).arg(total));
+            g_btHighlightNode = v.node;
+            drawBT(avl.root(), 400, 120, 200, 0);
+            g_btHighlightNode = nullptr;
+
+            QString how;
+            if (value < v.node->key) how = QStringLiteral("向左");
+            else if (value == v.node->key) how = QStringLiteral("命中，再加左子树 %1 个").arg(ls);
+            else how = QStringLiteral("左子树 %1 个和结点本身都更小，向右").arg(ls);
+            showMessage(QStringLiteral("AVL 排名：结点 %1，已数出 %2 个更小的键，%3")
+                            .arg(v.node->key).arg(v.below).arg(how));
+        });
+    }
+
+    steps.push_back([this, value, r, hit]() {
+        view->resetScene();
+        g_btHighlightNode = hit;
+        drawBT(avl.root(), 400, 120, 200, 0);
+        g_btHighlightNode = nullptr;
+        if (hit) {
+            view->setTitle(QStringLiteral("AVL 排名：%1 是第 %2 小").arg(value).arg(r + 1));
+        } else {
+            view->setTitle(QStringLiteral("AVL 排名：%1 不在树中，比它小的有 %2 个").arg(value).arg(r));
+        }
+        showMessage(QStringLiteral("AVL 排名：比 %1 小的键共 %2 个").arg(value).arg(r));
+    });
+
+    timer.start();
+    updateAnimUiState();
+}
+
 void MainWindow::avlClear() {
     avl.clear();
+    avlHistory.clear();
 
     timer.stop();
     steps.clear();
@@ -2419,7 +3156,7 @@ void MainWindow::avlClear() {
 }
 
 // ===== 绘制基础 =====
-void MainWindow::drawSeqlist(const ds::Seqlist& sl){
+void MainWindow::drawSeqlist(const ds::Seqlist<int>& sl, int highlightIdx){
     view->setCurrentFamily(QStringLiteral("seq"));
     view->resetScene();
     view->setTitle(QStringLiteral("顺序表"));
@@ -2432,7 +3169,7 @@ void MainWindow::drawSeqlist(const ds::Seqlist& sl){
         const qreal x = startX + i * (cellW + gap);
         const qreal y = startY;
 
-        view->addBox(x, y, cellW, cellH, QString::number(sl.get(i)), false);
+        view->addBox(x, y, cellW, cellH, QString::number(sl.get(i)), i == highlightIdx);
 
         auto* idx = view->Scene()->addText(QString::number(i));
         idx->setDefaultTextColor(Qt::darkGray);
@@ -2459,7 +3196,7 @@ void MainWindow::drawLinklist(const ds::Linklist& ll){
 
     while(p) {
         // 使用改进的节点样式
-        view->addNode(x, y, QString::number(ll.get(i)), false);
+        view->addNode(x, y, QString::number(p->value), false);
 
         // 改进的索引显示
         auto* idx = view->Scene()->addText(QString::number(i));
@@ -2492,6 +3229,115 @@ void MainWindow::drawLinklist(const ds::Linklist& ll){
     }
 }
 
+// 块状链表：每块画成一排分段格子（已用格子 + 空闲格子 + next 指针格）
+void MainWindow::drawUnrolledLinklist(const ds::UnrolledLinklist<>& ul, int highlightPos){
+    drawUnrolledBlocks(unrolledSnapshot(ul), highlightPos);
+}
+
+void MainWindow::drawUnrolledBlocks(const QVector<QVector<int>>& blocks, int highlightPos){
+    view->setCurrentFamily(QStringLiteral("link"));
+    view->resetScene(); view->setTitle(QStringLiteral("块状链表"));
+
+    const int cap = ds::UnrolledLinklist<>::blockCapacity();
+    const qreal cellW = 34, cellH = 44, ptrW = 22, gapX = 60;
+    const qreal y = 220, midY = y + cellH / 2;
+    const qreal blockW = cap * cellW + ptrW;
+    qreal x = 110;
+
+    auto* headLabel = view->Scene()->addText("head");
+    headLabel->setDefaultTextColor(QColor("#334155"));
+    headLabel->setFont(QFont("Arial", 10, QFont::Bold));
+    headLabel->setPos(30, midY - 10);
+
+    if (!blocks.isEmpty()) view->addEdge(QPointF(70, midY), QPointF(x, midY));
+
+    const int nb = blocks.size();
+    int base = 0, bi = 0;
+    for (; bi < nb; ++bi) {
+        const QVector<int>& b = blocks[bi];
+        const int count = b.size();
+        auto* lbl = view->Scene()->addText(QStringLiteral("块 %1（%2/%3）").arg(bi).arg(count).arg(cap));
+        lbl->setDefaultTextColor(QColor("#64748b"));
+        lbl->setFont(QFont("Arial", 9));
+        lbl->setPos(x, y - 26);
+
+        for (int k = 0; k < cap; ++k) {
+            const qreal cx = x + k * cellW;
+            if (k < count) {
+                view->addBox(cx, y, cellW, cellH, QString::number(b[k]), base + k == highlightPos);
+            } else {
+                view->Scene()->addRect(QRectF(cx, y, cellW, cellH), QPen(QColor("#cbd5e1"), 1, Qt::DashLine), QBrush(QColor("#f8fafc")));
+            }
+        }
+
+        // next 指针格
+        const qreal px = x + cap * cellW;
+        view->Scene()->addRect(QRectF(px, y, ptrW, cellH), view->elementPen(false), QBrush(QColor("#e2e8f0")));
+
+        // 块下方标出该块覆盖的下标区间
+        auto* range = view->Scene()->addText(QStringLiteral("[%1, %2]").arg(base).arg(base + count - 1));
+        range->setDefaultTextColor(QColor("#64748b"));
+        range->setFont(QFont("Arial", 9));
+        range->setPos(x, y + cellH + 6);
+
+        if (bi + 1 < nb) view->addEdge(QPointF(px + ptrW / 2, midY), QPointF(x + blockW + gapX, midY));
+
+        base += count;
+        x += blockW + gapX;
+    }
+
+    if (bi > 0) {
+        auto* tailLabel = view->Scene()->addText("tail");
+        tailLabel->setDefaultTextColor(QColor("#334155"));
+        tailLabel->setFont(QFont("Arial", 10, QFont::Bold));
+        tailLabel->setPos(x - gapX + 8, midY - 10);
+    }
+}
+
+// 双链表：next 指针画在结点连线上方，prev 指针画在下方
+void MainWindow::drawDLinklist(const ds::DLinklist& dl, int highlightPos){
+    view->setCurrentFamily(QStringLiteral("link"));
+    view->resetScene(); view->setTitle(QStringLiteral("双链表"));
+    const qreal y = 220;
+
+    auto* headLabel = view->Scene()->addText("head");
+    headLabel->setDefaultTextColor(QColor("#334155"));
+    headLabel->setFont(QFont("Arial", 10, QFont::Bold));
+    headLabel->setPos(30, y-10);
+
+    int i = 0;
+    for (auto it = dl.begin(); it != dl.end(); ++it, ++i) {
+        const QPointF c = dlinkCenter(i);
+        view->addNode(c.x(), y, QString::number(*it), i == highlightPos);
+
+        auto* idx = view->Scene()->addText(QString::number(i));
+        idx->setDefaultTextColor(QColor("#64748b"));
+        idx->setFont(QFont("Arial", 9));
+        idx->setPos(c.x()-8, y+45);
+
+        if (i == 0) view->addEdge(QPointF(60, y), QPointF(c.x()-35, y));
+        if (it.node()->next) {
+            const QPointF d = dlinkCenter(i + 1);
+            view->addEdge(QPointF(c.x()+34, y-10), QPointF(d.x()-34, y-10));  // next
+            view->addEdge(QPointF(d.x()-34, y+10), QPointF(c.x()+34, y+10));  // prev
+        }
+    }
+
+    if (i > 0) {
+        const qreal tx = dlinkCenter(i).x() - 40;
+        auto* tailLabel = view->Scene()->addText("tail");
+        tailLabel->setDefaultTextColor(QColor("#334155"));
+        tailLabel->setFont(QFont("Arial", 10, QFont::Bold));
+        tailLabel->setPos(tx+4, y-10);
+        view->addEdge(QPointF(tx, y), QPointF(dlinkCenter(i - 1).x()+35, y));
+
+        auto* legend = view->Scene()->addText(QStringLiteral("上方箭头：next　下方箭头：prev"));
+        legend->setDefaultTextColor(QColor("#64748b"));
+        legend->setFont(QFont("Arial", 9));
+        legend->setPos(30, y-130);
+    }
+}
+
 void MainWindow::drawStack(const ds::Stack& st){
     view->setCurrentFamily(QStringLiteral("stack"));
     view->resetScene(); view->setTitle(QStringLiteral("顺序栈（U 型槽：自适应高度）"));
@@ -2530,14 +3376,14 @@ void MainWindow::drawBT(ds::BTNode* root, qreal x, qreal y, qreal /*distance*/,
     QHash<ds::BTNode*, int> depth;      // 结点 -> 层深
     int idx = 0;
 
-    std::function<void(ds::BTNode*, int)> inorder = [&](ds::BTNode* p, int d){
-        if (!p) return;
-        inorder(p->left,  d + 1);
-        xIndex[p] = idx++;
-        depth[p] = d;
-        inorder(p->right, d + 1);
-    };
-    inorder(root, 0);
+    // 非递归遍历：先序时父结点先于孩子，顺手算层深；斜链也不会爆栈
+    depth[root] = 0;
+    ds::BinaryTree::preorderWalk(root, [&](ds::BTNode* p){
+        const int d = depth.value(p);
+        if (p->left)  depth[p->left]  = d + 1;
+        if (p->right) depth[p->right] = d + 1;
+    });
+    ds::BinaryTree::inorderWalk(root, [&](ds::BTNode* p){ xIndex[p] = idx++; });
     if (idx <= 0) return;
 
     // 2) 把“序号坐标”映射为像素坐标，并整体居中
@@ -2554,34 +3400,29 @@ void MainWindow::drawBT(ds::BTNode* root, qreal x, qreal y, qreal /*distance*/,
     }
 
     // 3) 先画边再画点（确保连线在底层，圆点在上层）
-    std::function<void(ds::BTNode*)> drawRec = [&](ds::BTNode* p){
-        if (!p) return;
+    ds::BinaryTree::preorderWalk(root, [&](ds::BTNode* p){
         const QPointF cp = pos[p];
-
         if (p->left) {
             const QPointF cl = pos[p->left];
             view->addEdge(QPointF(cp.x(), cp.y() + 34), QPointF(cl.x(), cl.y() - 34));
-            drawRec(p->left);
         }
         if (p->right) {
             const QPointF cr = pos[p->right];
             view->addEdge(QPointF(cp.x(), cp.y() + 34), QPointF(cr.x(), cr.y() - 34));
-            drawRec(p->right);
         }
-
+    });
+    ds::BinaryTree::preorderWalk(root, [&](ds::BTNode* p){
         // 关键改动：只按“结点指针”高亮，完全不再看 key
+        const QPointF cp = pos[p];
         const bool hl = (p == g_btHighlightNode);
         view->addNode(cp.x(), cp.y(), QString::number(p->key), hl);
-    };
-    drawRec(root);
+    });
 }
 
-void MainWindow::drawAVL(int v, const QVector<int>& restoreKeys, int idx, int total) {
-    // 步骤1：插入前的静态画面
+void MainWindow::drawAVL(int v, ds::PersistentAVL::Version before, ds::PersistentAVL::Version after,
+                         const std::vector<ds::AVL::RotationRecord>& recs, int idx, int total) {
+    // 步骤1：插入前的静态画面（版本只读，重播时直接重画）
     steps.push_back([=, this]() {
-        avl.clear();
-        for (int k : restoreKeys) avl.insert(k);
-
         // 清掉可能残留的“按指针高亮”
         g_btHighlightNode = nullptr;
 
@@ -2589,7 +3430,7 @@ void MainWindow::drawAVL(int v, const QVector<int>& restoreKeys, int idx, int to
         view->setTitle(
             QStringLiteral("AVL树：准备插入 %1（第 %2/%3 步）").arg(v).arg(idx + 1).arg(total)
         );
-        drawBT(avl.root(), 400, 120, 200, 0);
+        drawBT(before, 400, 120, 200, 0);
         showMessage(QStringLiteral("AVL树：准备插入 %1").arg(v));
     });
 
@@ -2698,18 +3539,16 @@ void MainWindow::drawAVL(int v, const QVector<int>& restoreKeys, int idx, int to
 
         // 1）插入前布局（可留作兜底，不作为旋转动画起点）
         QHash<ds::BTNode*, QPointF> posBefore;
-        computePos(avl.root(), 400, 120, posBefore);
+        computePos(before, 400, 120, posBefore);
 
         // 2）克隆一份“插入前”的树，用于模拟“旋转前的 BST 直接插入形态”
-        ds::BTNode* simRoot = simClone(avl.root());
+        ds::BTNode* simRoot = simClone(before);
 
-        // 3）真正插入（AVL 会旋转，并记录 rotationRecords）
-        avl.insert(v);
-        const auto& recs = avl.rotationRecords();
+        // 3）插入后的版本与旋转记录在准备阶段已经算好（recs 指向 after 中的结点）
 
         // 4）插入后布局（最终平衡树）
         QHash<ds::BTNode*, QPointF> posAfter;
-        computePos(avl.root(), 400, 120, posAfter);
+        computePos(after, 400, 120, posAfter);
 
         // 把最终布局也做一个 key->pos 映射（用于动画的终点）
         QHash<int, QPointF> posAfterKey;
@@ -2725,7 +3564,7 @@ void MainWindow::drawAVL(int v, const QVector<int>& restoreKeys, int idx, int to
 
             view->resetScene();
             view->setTitle(QStringLiteral("AVL树：插入 %1（无需旋转）").arg(v));
-            drawBT(avl.root(), 400, 120, 200, 0);
+            drawBT(after, 400, 120, 200, 0);
             showMessage(QStringLiteral("AVL树：插入 %1 后仍然平衡，无需旋转").arg(v));
             return;
         }
@@ -2834,7 +3673,7 @@ void MainWindow::drawAVL(int v, const QVector<int>& restoreKeys, int idx, int to
                     fillPos(p->left);
                     fillPos(p->right);
                 };
-                fillPos(avl.root());
+                fillPos(after);
 
                 std::function<void(ds::BTNode*)> drawRec = [&](ds::BTNode* p) {
                     if (!p) return;
@@ -2856,7 +3695,7 @@ void MainWindow::drawAVL(int v, const QVector<int>& restoreKeys, int idx, int to
                     bool hl = (p == h1 || p == h2 || p == h3);
                     view->addNode(cp.x(), cp.y(), QString::number(p->key), hl);
                 };
-                drawRec(avl.root());
+                drawRec(after);
 
                 if (frame == frames) {
                     showMessage(endMsg);
@@ -2921,7 +3760,7 @@ void MainWindow::drawAVL(int v, const QVector<int>& restoreKeys, int idx, int to
                                 g_btHighlightNode = nullptr;
                                 view->resetScene();
                                 view->setTitle(QStringLiteral("AVL树：插入 %1（旋转完成）").arg(v));
-                                drawBT(avl.root(), 400, 120, 200, 0);
+                                drawBT(after, 400, 120, 200, 0);
 
                                 if (stepIndex < steps.size()) {
                                     timer.start();
@@ -2952,7 +3791,7 @@ void MainWindow::drawAVL(int v, const QVector<int>& restoreKeys, int idx, int to
                         g_btHighlightNode = nullptr;
                         view->resetScene();
                         view->setTitle(QStringLiteral("AVL树：插入 %1（旋转完成）").arg(v));
-                        drawBT(avl.root(), 400, 120, 200, 0);
+                        drawBT(after, 400, 120, 200, 0);
 
                         if (stepIndex < steps.size()) {
                             timer.start();
@@ -2966,3 +3805,264 @@ void MainWindow::drawAVL(int v, const QVector<int>& restoreKeys, int idx, int to
     });
 }
 
+
+// ===== AVL 删除动画 =====
+// 删除可能引发多次旋转，而每次旋转后树的连边都不同，所以这里按“键”拍快照：键 -> 坐标 + 父子连边
+namespace {
+struct AVLKeyFrame {
+    QHash<int, QPointF> pos;
+    QVector<QPair<int, int>> edges;
+};
+
+AVLKeyFrame avlKeyFrame(ds::BTNode* root, qreal x, qreal y) {
+    AVLKeyFrame f;
+    if (!root) return f;
+    QHash<ds::BTNode*, int> depth;
+    depth[root] = 0;
+    ds::BinaryTree::preorderWalk(root, [&](ds::BTNode* p) {
+        const int d = depth.value(p);
+        if (p->left)  { depth[p->left]  = d + 1; f.edges.push_back({p->key, p->left->key}); }
+        if (p->right) { depth[p->right] = d + 1; f.edges.push_back({p->key, p->right->key}); }
+    });
+    QVector<ds::BTNode*> order;
+    ds::BinaryTree::inorderWalk(root, [&](ds::BTNode* p) { order.push_back(p); });
+
+    // 与 drawBT 同一套布局：中序序号 * 80 居中，层深 * 100
+    const qreal stepX = 80.0, levelH = 100.0;
+    const qreal mid = ((order.size() - 1) * stepX) / 2.0;
+    for (int i = 0; i < order.size(); ++i) {
+        f.pos[order[i]->key] = QPointF(x + i * stepX - mid, y + depth.value(order[i]) * levelH);
+    }
+    return f;
+}
+
+// 模拟树：只有 key/left/right，用完整体释放
+ds::BTNode* avlSimClone(const ds::BTNode* src) {
+    if (!src) return nullptr;
+    auto* p = static_cast<ds::BTNode*>(std::malloc(sizeof(ds::BTNode)));
+    if (!p) return nullptr;
+    p->key = src->key;
+    p->left = avlSimClone(src->left);
+    p->right = avlSimClone(src->right);
+    return p;
+}
+
+void avlSimDestroy(ds::BTNode* p) {
+    if (!p) return;
+    avlSimDestroy(p->left);
+    avlSimDestroy(p->right);
+    std::free(p);
+}
+
+ds::BTNode** avlSimFindRef(ds::BTNode*& rt, int key) {
+    ds::BTNode** ref = &rt;
+    while (*ref && (*ref)->key != key) ref = (key < (*ref)->key) ? &(*ref)->left : &(*ref)->right;
+    return *ref ? ref : nullptr;
+}
+
+// 与 AVL::erase 相同的删除规则（两个孩子时用中序后继的键覆盖），但不做再平衡
+void avlSimBstErase(ds::BTNode*& root, int key) {
+    ds::BTNode** ref = avlSimFindRef(root, key);
+    if (!ref) return;
+    ds::BTNode* t = *ref;
+    if (t->left && t->right) {
+        ds::BTNode** s = &t->right;
+        while ((*s)->left) s = &(*s)->left;
+        ds::BTNode* succ = *s;
+        t->key = succ->key;
+        *s = succ->right;
+        std::free(succ);
+    } else {
+        *ref = t->left ? t->left : t->right;
+        std::free(t);
+    }
+}
+
+void avlSimRotateLeft(ds::BTNode*& k2) {
+    if (!k2 || !k2->right) return;
+    ds::BTNode* k1 = k2->right;
+    k2->right = k1->left;
+    k1->left = k2;
+    k2 = k1;
+}
+
+void avlSimRotateRight(ds::BTNode*& k2) {
+    if (!k2 || !k2->left) return;
+    ds::BTNode* k1 = k2->left;
+    k2->left = k1->right;
+    k1->right = k2;
+    k2 = k1;
+}
+} // namespace
+
+void MainWindow::drawAVLErase(int v, ds::PersistentAVL::Version before, ds::PersistentAVL::Version after,
+                              const std::vector<ds::AVL::RotationRecord>& recs) {
+    ds::BTNode* target = before;
+    while (target && target->key != v) target = (v < target->key) ? target->left : target->right;
+
+    // 步骤1：删除前的静态画面，高亮要删除的结点
+    steps.push_back([=, this]() {
+        g_btHighlightNode = target;
+        view->resetScene();
+        view->setTitle(QStringLiteral("AVL树：准备删除 %1").arg(v));
+        drawBT(before, 400, 120, 200, 0);
+        g_btHighlightNode = nullptr;
+        showMessage(target ? QStringLiteral("AVL树：准备删除 %1").arg(v)
+                           : QStringLiteral("AVL树：未找到结点 %1").arg(v));
+    });
+
+    if (!target) {
+        steps.push_back([=, this]() {
+            view->resetScene();
+            view->setTitle(QStringLiteral("AVL树：删除 %1（结点不存在）").arg(v));
+            drawBT(before, 400, 120, 200, 0);
+            showMessage(QStringLiteral("AVL树：删除失败，未找到结点 %1").arg(v));
+        });
+        return;
+    }
+    if (recs.empty()) {
+        steps.push_back([=, this]() {
+            view->resetScene();
+            view->setTitle(QStringLiteral("AVL树：删除 %1（无需旋转）").arg(v));
+            drawBT(after, 400, 120, 200, 0);
+            showMessage(QStringLiteral("AVL树：删除 %1 后仍然平衡，无需旋转").arg(v));
+        });
+        return;
+    }
+
+    // 准备阶段：在 before 的副本上按 BST 规则删除，再依次套用旋转记录，得到每一段动画的起止快照
+    // 每一段动画：从 from 帧移动到 to 帧，连边用 to 帧的结构，高亮参与旋转的键
+    struct Stage {
+        AVLKeyFrame from, to;
+        QVector<int> hl;
+        QString title, msg;
+    };
+    QVector<Stage> stages;
+
+    ds::BTNode* simRoot = avlSimClone(before);
+    avlSimBstErase(simRoot, v);
+    AVLKeyFrame cur = avlKeyFrame(simRoot, 400, 120);
+    const AVLKeyFrame erased = cur;
+
+    auto keyOf = [](const ds::BTNode* p) { return p ? QString::number(p->key) : QStringLiteral("?"); };
+    for (int i = 0; i < static_cast<int>(recs.size()); ++i) {
+        const auto& r = recs[i];
+        const int zKey = r.z->key, yKey = r.y->key;
+        const QVector<int> hl{zKey, yKey, r.x ? r.x->key : zKey};
+        const QString no = QStringLiteral("第 %1/%2 次失衡").arg(i + 1).arg(static_cast<int>(recs.size()));
+
+        ds::BTNode** zRef = avlSimFindRef(simRoot, zKey);
+        if (!zRef) break;
+
+        auto push = [&](const QString& title, const QString& msg) {
+            AVLKeyFrame next = avlKeyFrame(simRoot, 400, 120);
+            stages.push_back({cur, next, hl, title, msg});
+            cur = next;
+        };
+
+        switch (r.type) {
+        case ds::AVL::RotationRecord::LL:
+            avlSimRotateRight(*zRef);
+            push(QStringLiteral("LL %1").arg(no),
+                 QStringLiteral("AVL树：结点 %1 失衡（LL），对 z=%1 右旋").arg(zKey));
+            break;
+        case ds::AVL::RotationRecord::RR:
+            avlSimRotateLeft(*zRef);
+            push(QStringLiteral("RR %1").arg(no),
+                 QStringLiteral("AVL树：结点 %1 失衡（RR），对 z=%1 左旋").arg(zKey));
+            break;
+        case ds::AVL::RotationRecord::LR:
+            avlSimRotateLeft((*zRef)->left);
+            push(QStringLiteral("LR %1 第1次旋转").arg(no),
+                 QStringLiteral("AVL树：LR 第1次旋转：对 y=%1 左旋（涉及 x=%2）").arg(yKey).arg(keyOf(r.x)));
+            avlSimRotateRight(*zRef);
+            push(QStringLiteral("LR %1 第2次旋转").arg(no),
+                 QStringLiteral("AVL树：LR 第2次旋转：对 z=%1 右旋").arg(zKey));
+            break;
+        case ds::AVL::RotationRecord::RL:
+            avlSimRotateRight((*zRef)->right);
+            push(QStringLiteral("RL %1 第1次旋转").arg(no),
+                 QStringLiteral("AVL树：RL 第1次旋转：对 y=%1 右旋（涉及 x=%2）").arg(yKey).arg(keyOf(r.x)));
+            avlSimRotateLeft(*zRef);
+            push(QStringLiteral("RL %1 第2次旋转").arg(no),
+                 QStringLiteral("AVL树：RL 第2次旋转：对 z=%1 左旋").arg(zKey));
+            break;
+        }
+    }
+    avlSimDestroy(simRoot);
+    const int rotations = static_cast<int>(recs.size());
+
+    // 步骤2：先显示 BST 删除后的形态，再逐次播放每个旋转（LR/RL 拆成两段单旋）
+    steps.push_back([=, this]() {
+        // 先展示“旋转前”：按 BST 规则删除后的形态
+        auto drawFrame = [this](const AVLKeyFrame& from, const AVLKeyFrame& to, qreal t, const QVector<int>& hl) {
+            QHash<int, QPointF> now;
+            for (auto it = to.pos.constBegin(); it != to.pos.constEnd(); ++it) {
+                const QPointF a = from.pos.value(it.key(), it.value());
+                now.insert(it.key(), QPointF(lerp(a.x(), it.value().x(), t), lerp(a.y(), it.value().y(), t)));
+            }
+            for (const auto& e : to.edges) {
+                const QPointF cp = now.value(e.first), cc = now.value(e.second);
+                view->addEdge(QPointF(cp.x(), cp.y() + 34), QPointF(cc.x(), cc.y() - 34));
+            }
+            for (auto it = now.constBegin(); it != now.constEnd(); ++it) {
+                view->addNode(it.value().x(), it.value().y(), QString::number(it.key()), hl.contains(it.key()));
+            }
+        };
+
+        view->resetScene();
+        view->setTitle(QStringLiteral("AVL树：删除 %1（旋转前：BST 删除后的形态）").arg(v));
+        drawFrame(erased, erased, 1.0, {});
+        showMessage(QStringLiteral("AVL树：先按 BST 规则删除 %1，再自底向上检查失衡，共 %2 次失衡")
+                        .arg(v).arg(rotations));
+
+        // 暂停外层 steps 的定时器，交给 QTimeLine 逐段播放
+        timer.stop();
+        gifActiveTimelines_ += static_cast<int>(stages.size());
+
+        const int frames   = 18;
+        const int duration = animTimelineDurationMs_;
+
+        auto finish = [=, this]() {
+            g_btHighlightNode = nullptr;
+            view->resetScene();
+            view->setTitle(QStringLiteral("AVL树：删除 %1（旋转完成）").arg(v));
+            drawBT(after, 400, 120, 200, 0);
+
+            if (stepIndex < steps.size()) {
+                timer.start();
+            } else {
+                showMessage(QStringLiteral("播放结束"));
+            }
+        };
+
+        // 逐段串联：第 i 段结束后启动第 i+1 段（函数自身只持弱引用，由正在播放的 QTimeLine 持有强引用，避免循环引用）
+        auto runStage = std::make_shared<std::function<void(int)>>();
+        std::weak_ptr<std::function<void(int)>> weakRun = runStage;
+        *runStage = [=, this](int i) {
+            if (i >= stages.size()) { finish(); return; }
+            auto self = weakRun.lock();
+            const Stage st = stages[i];
+
+            QTimeLine* tl = new QTimeLine(duration, this);
+            tl->setFrameRange(0, frames);
+            connect(tl, &QTimeLine::frameChanged, this, [=, this](int frame) {
+                const qreal t = (frames == 0) ? 1.0 : qreal(frame) / frames;
+                view->resetScene();
+                view->setTitle(QStringLiteral("AVL树：删除 %1（%2 %3/%4）").arg(v).arg(st.title).arg(frame).arg(frames));
+                drawFrame(st.from, st.to, t, st.hl);
+                if (frame == frames) showMessage(st.msg);
+            });
+            connect(tl, &QTimeLine::finished, this, [=, this]() {
+                tl->deleteLater();
+                if (gifActiveTimelines_ > 0) --gifActiveTimelines_;
+                maybeFinishGifExport();
+                if (self) (*self)(i + 1);
+            });
+            tl->start();
+        };
+
+        // 给用户留一小段时间看清删除后的形态，再启动旋转动画
+        QTimer::singleShot(220, this, [runStage]() { (*runStage)(0); });
+    });
+}
@@ -62,6 +62,11 @@ QWidget* MainWindow::buildLinklistPage() {
     auto* form = new QWidget; auto* f = new QFormLayout(form);
     linklistInput = new QLineEdit; linklistInput->setPlaceholderText("例如: 1 2 3 4");
     f->addRow("初始序列", linklistInput);
+    linklistMode = new QComboBox;
+    linklistMode->addItem("单链表（每结点 1 个值）");
+    linklistMode->addItem(QString("块状链表（每块 %1 个值）").arg(ds::UnrolledLinklist<>::blockCapacity()));
+    linklistMode->addItem("双链表（prev/next 双向指针）");
+    f->addRow("存储方式", linklistMode);
 
     auto* row0 = new QWidget; auto* hb0 = new QHBoxLayout(row0);
     auto* btnRebuild = new QPushButton("建立"); btnRebuild->setStyleSheet("QPushButton{background:#22c55e;color:white;}");
@@ -86,6 +91,7 @@ QWidget* MainWindow::buildLinklistPage() {
     connect(btnClear, &QPushButton::clicked,this,&MainWindow::linklistClear);
     connect(btnIns,   &QPushButton::clicked,this,&MainWindow::linklistInsert);
     connect(btnDel,   &QPushButton::clicked,this,&MainWindow::linklistErase);
+    connect(linklistMode, &QComboBox::currentIndexChanged, this, [this](int idx){ setLinklistMode(static_cast<LinkMode>(idx)); });
     return root;
 }
 
@@ -168,15 +174,18 @@ QWidget* MainWindow::buildBSTPage() {
     auto* row0 = new QWidget; auto* hb0 = new QHBoxLayout(row0);
     auto* btnBuild = new QPushButton("建立"); btnBuild->setStyleSheet("QPushButton{background:#22c55e;color:white;}");
     auto* btnClear = new QPushButton("清空"); btnClear->setStyleSheet("QPushButton{background:#ef4444;color:white;}");
-    hb0->addWidget(btnBuild); hb0->addWidget(btnClear);
+    auto* btnBalance = new QPushButton("平衡化"); btnBalance->setStyleSheet("QPushButton{background:#8b5cf6;color:white;}");
+    hb0->addWidget(btnBuild); hb0->addWidget(btnClear); hb0->addWidget(btnBalance);
 
     auto* row1 = new QWidget; auto* hb1 = new QHBoxLayout(row1);
     bstValue = new QLineEdit; bstValue->setPlaceholderText("键值");
     auto* btnFind = new QPushButton("查找"); btnFind->setStyleSheet("QPushButton{background:#3b82f6;color:white;}");
     auto* btnInsert = new QPushButton("插入"); btnInsert->setStyleSheet("QPushButton{background:#10b981;color:white;}"); // 新增插入按钮
     auto* btnDel  = new QPushButton("删除"); btnDel ->setStyleSheet("QPushButton{background:#f59e0b;color:white;}");
+    auto* btnKth  = new QPushButton("第k小"); btnKth ->setStyleSheet("QPushButton{background:#8b5cf6;color:white;}"); // 输入框里的值当作 k
     hb1->addWidget(new QLabel("值:")); hb1->addWidget(bstValue);
     hb1->addWidget(btnFind); hb1->addWidget(btnInsert); hb1->addWidget(btnDel); // 添加插入按钮
+    hb1->addWidget(btnKth);
 
     v->addWidget(wrapGroup("BST 建立", form));
     v->addWidget(wrapGroup("BST 操作", row0));
@@ -185,9 +194,11 @@ QWidget* MainWindow::buildBSTPage() {
 
     connect(btnBuild,&QPushButton::clicked,this,&MainWindow::bstBuild);
     connect(btnClear,&QPushButton::clicked,this,&MainWindow::bstClear);
+    connect(btnBalance,&QPushButton::clicked,this,&MainWindow::bstBalance);
     connect(btnFind, &QPushButton::clicked,this,&MainWindow::bstFind);
     connect(btnInsert, &QPushButton::clicked,this,&MainWindow::bstInsert); // 连接插入按钮
     connect(btnDel,  &QPushButton::clicked,this,&MainWindow::bstErase);
+    connect(btnKth,  &QPushButton::clicked,this,&MainWindow::bstKth);
     return root;
 }
 
@@ -207,6 +218,11 @@ QWidget* MainWindow::buildHuffmanPage() {
     huffmanInput->setPlaceholderText(QStringLiteral("例如：1 2 3 4 5（用空格或逗号分隔）"));
     f->addRow(QStringLiteral("权值序列"), huffmanInput);
 
+    huffmanMaxLen = new QSpinBox;
+    huffmanMaxLen->setRange(1, 30);
+    huffmanMaxLen->setValue(3);
+    f->addRow(QStringLiteral("最大码长"), huffmanMaxLen);
+
     // ===== 构建 / 清空 按钮行 =====
     auto* row0 = new QWidget;
     auto* hb0 = new QHBoxLayout(row0);
@@ -215,15 +231,21 @@ QWidget* MainWindow::buildHuffmanPage() {
 
     auto* btnBuild = new QPushButton(QStringLiteral("构建哈夫曼树"));
     auto* btnClear = new QPushButton(QStringLiteral("清空"));
+    auto* btnLimit = new QPushButton(QStringLiteral("限长编码"));
+    auto* btnEncode = new QPushButton(QStringLiteral("编码文件"));
 
     //btnBuild->setMinimumHeight(32);
     //btnClear->setMinimumHeight(32);
 
     btnBuild->setStyleSheet("QPushButton{background:#22c55e;color:white;}");
     btnClear->setStyleSheet("QPushButton{background:#ef4444;color:white;}");
+    btnLimit->setStyleSheet("QPushButton{background:#3b82f6;color:white;}");
+    btnEncode->setStyleSheet("QPushButton{background:#3b82f6;color:white;}");
 
     hb0->addWidget(btnBuild);
     hb0->addWidget(btnClear);
+    hb0->addWidget(btnLimit);
+    hb0->addWidget(btnEncode);
 
     // ===== 新增：编码结果表格 =====
     auto* codeWidget = new QWidget;
@@ -287,6 +309,11 @@ QWidget* MainWindow::buildHuffmanPage() {
     // 信号连接
     connect(btnBuild, &QPushButton::clicked, this, &MainWindow::huffmanBuild);
     connect(btnClear, &QPushButton::clicked, this, &MainWindow::huffmanClear);
+    connect(btnLimit, &QPushButton::clicked, this, &MainWindow::huffmanLimit);
+    connect(btnEncode, &QPushButton::clicked, this, [this]() {
+        const QString path = QFileDialog::getOpenFileName(this, QStringLiteral("选择要编码的文件"));
+        if (!path.isEmpty()) huffmanEncodeFile(path);
+    });
 
     return root;
 }
@@ -307,17 +334,21 @@ QWidget* MainWindow::buildAVLPage() {
     auto* row1 = new QWidget; auto* hb1 = new QHBoxLayout(row1);
     avlValue = new QLineEdit; avlValue->setPlaceholderText("键值");
     auto* btnInsert = new QPushButton("插入"); btnInsert->setStyleSheet("QPushButton{background:#3b82f6;color:white;}");
+    auto* btnErase  = new QPushButton("删除"); btnErase->setStyleSheet("QPushButton{background:#ef4444;color:white;}");
     hb1->addWidget(new QLabel("值:")); hb1->addWidget(avlValue);
-    hb1->addWidget(btnInsert);
+    auto* btnRank   = new QPushButton("排名"); btnRank->setStyleSheet("QPushButton{background:#8b5cf6;color:white;}");
+    hb1->addWidget(btnInsert); hb1->addWidget(btnErase); hb1->addWidget(btnRank);
 
     v->addWidget(wrapGroup("AVL树建立", form));
     v->addWidget(wrapGroup("AVL树操作", row0));
-    v->addWidget(wrapGroup("插入", row1));
+    v->addWidget(wrapGroup("插入 / 删除 / 排名", row1));
     v->addStretch(1);
 
     connect(btnBuild,&QPushButton::clicked,this,&MainWindow::avlBuild);
     connect(btnClear,&QPushButton::clicked,this,&MainWindow::avlClear);
     connect(btnInsert,&QPushButton::clicked,this,&MainWindow::avlInsert);
+    connect(btnErase,&QPushButton::clicked,this,&MainWindow::avlErase);
+    connect(btnRank,&QPushButton::clicked,this,&MainWindow::avlRank);
     return root;
 }
 
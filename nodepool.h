@@ -0,0 +1,133 @@
+//
+// Created by xiang on 26-10-17.
+//
+
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+
+namespace ds {
+
+    // 结点池：按块（chunk）批量申请结点内存，一块里连续切出 ChunkNodes 个结点。
+    // - alloc()   先复用空闲链表，再从当前块里顺序切，块用完了再挂一块新的；
+    // - release() 把单个结点挂回空闲链表（不还给系统）；
+    // - reset()   一次性“回收”所有结点：块全部保留、从头复用，O(1)；
+    // - 析构       逐块 free，O(块数)。
+    // 只适用于平凡类型的结点（不调用构造/析构，和原来 malloc 出来的结点用法一致）。
+    template <typename Node, int ChunkNodes = 256>
+    class NodePool {
+        static_assert(std::is_trivially_destructible_v<Node>, "NodePool only holds trivial node types");
+        static_assert(sizeof(Node) >= sizeof(void*), "node must be large enough to hold a free-list link");
+        static_assert(ChunkNodes > 0, "chunk must hold at least one node");
+
+        struct Chunk {
+            Chunk *next;
+            // 结点紧跟在块头后面，起始地址按结点的对齐要求向上取整（支持按缓存行对齐的结点）
+            Node *nodes() {
+                const std::uintptr_t p = reinterpret_cast<std::uintptr_t>(this) + sizeof(Chunk);
+                const std::uintptr_t al = alignof(Node);
+                return reinterpret_cast<Node*>((p + al - 1) / al * al);
+            }
+        };
+
+        struct FreeSlot { FreeSlot *next; };
+
+        static constexpr std::size_t chunkBytes() {
+            // 多留 alignof(Node) 字节给对齐补齐
+            return sizeof(Chunk) + alignof(Node) + sizeof(Node) * static_cast<std::size_t>(ChunkNodes);
+        }
+
+        Chunk *first;      // 第一块
+        Chunk *cur;        // 正在切分的块
+        int used;          // cur 中已经切出去的结点数
+        FreeSlot *freeList;
+        int live;          // 当前在用的结点数
+        int chunks;        // 已申请的块数
+
+        Chunk* newChunk() {
+            void *p = std::malloc(chunkBytes());
+            if (!p) return nullptr;
+            Chunk *c = static_cast<Chunk*>(p);
+            c->next = nullptr;
+            ++chunks;
+            return c;
+        }
+
+    public:
+        NodePool() : first(nullptr), cur(nullptr), used(0), freeList(nullptr), live(0), chunks(0) {}
+
+        ~NodePool() { purge(); }
+
+        NodePool(const NodePool&) = delete;
+        NodePool& operator=(const NodePool&) = delete;
+
+        // 取一个未初始化的结点，失败返回 nullptr
+        Node* alloc() {
+            if (freeList) {
+                FreeSlot *s = freeList;
+                freeList = s->next;
+                ++live;
+                return reinterpret_cast<Node*>(s);
+            }
+            if (!cur || used == ChunkNodes) {
+                // 当前块用完：优先复用 reset() 之前留下的后续块
+                Chunk *nx = cur ? cur->next : first;
+                if (!nx) {
+                    nx = newChunk();
+                    if (!nx) return nullptr;
+                    if (cur) cur->next = nx;
+                    else first = nx;
+                }
+                cur = nx;
+                used = 0;
+            }
+            ++live;
+            return cur->nodes() + used++;
+        }
+
+        // 归还单个结点
+        void release(Node *p) {
+            if (!p) return;
+            FreeSlot *s = reinterpret_cast<FreeSlot*>(p);
+            s->next = freeList;
+            freeList = s;
+            --live;
+        }
+
+        // 所有结点作废，块保留下来供下次复用
+        void reset() {
+            cur = nullptr;
+            used = 0;
+            freeList = nullptr;
+            live = 0;
+        }
+
+        // 释放所有块
+        void purge() {
+            Chunk *c = first;
+            while (c) {
+                Chunk *nx = c->next;
+                std::free(c);
+                c = nx;
+            }
+            first = cur = nullptr;
+            used = 0;
+            freeList = nullptr;
+            live = 0;
+            chunks = 0;
+        }
+
+        int liveNodes() const { return live; }
+        int chunkCount() const { return chunks; }
+        // 向系统申请的字节数（含块头与对齐补齐） / 在用结点占的字节数
+        std::size_t bytesReserved() const { return static_cast<std::size_t>(chunks) * chunkBytes(); }
+        std::size_t bytesInUse() const { return static_cast<std::size_t>(live) * sizeof(Node); }
+    };
+
+} // namespace ds
+
+#endif // NODEPOOL_H
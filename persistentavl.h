@@ -0,0 +1,137 @@
+//
+// Created by xiang on 26-10-17.
+//
+
+#ifndef PERSISTENTAVL_H
+#define PERSISTENTAVL_H
+
+#include "avl.h"
+#include "nodepool.h"
+#include <vector>
+
+namespace ds {
+
+    // 持久化 AVL（路径复制）：插入不改动旧版本，只复制根到插入点路径上的 O(log n) 个结点，其余子树与旧版本共享
+    // - 一个版本就是一个根指针（nullptr 为空树），结点建成后不再修改，任意版本都可以直接交给 drawBT 绘制；
+    // - 结点来自结点池，只能整体回收：clear() 之后此前得到的所有版本都失效；
+    // - 旋转记录与 AVL::RotationRecord 相同，z/y/x 指向新版本中的结点。
+    class PersistentAVL {
+    public:
+        using Version = BTNode*;
+        using RotationRecord = AVL::RotationRecord;
+
+        PersistentAVL() = default;
+        PersistentAVL(const PersistentAVL&) = delete;
+        PersistentAVL& operator=(const PersistentAVL&) = delete;
+
+        // 在版本 v 上插入 key，返回新版本；key 已存在时原样返回 v；结点申请失败返回 nullptr
+        Version insert(Version v, int key) {
+            rotationRecords_.clear();
+            for (const BTNode* p = v; p; p = key < p->key ? p->left : p->right) {
+                if (p->key == key) return v;
+            }
+            return insert_(v, key);
+        }
+
+        // 把一棵普通的（可修改的）树复制成一个版本，O(n)；失败返回 nullptr
+        Version adopt(const BTNode* root) {
+            if (!root) return nullptr;
+            BTNode* p = pool.alloc();
+            if (!p) return nullptr;
+            *p = *root;
+            p->left = adopt(root->left);    // AVL 高度 O(log n)，递归不会太深
+            p->right = adopt(root->right);
+            pull(p);
+            return p;
+        }
+
+        // 最近一次 insert 的旋转记录
+        const std::vector<RotationRecord>& rotationRecords() const { return rotationRecords_; }
+
+        // 回收所有版本的结点（结点池的块保留，下一批版本直接复用）
+        void clear() { pool.reset(); rotationRecords_.clear(); }
+
+        // 所有版本合计占用的结点数
+        int nodeCount() const { return pool.liveNodes(); }
+
+    private:
+        NodePool<BTNode> pool;
+        std::vector<RotationRecord> rotationRecords_;
+
+        static int heightOf(const BTNode* p) { return p ? p->height : 0; }
+        static int sizeOf(const BTNode* p) { return p ? p->size : 0; }
+        static void pull(BTNode* p) {
+            const int lh = heightOf(p->left), rh = heightOf(p->right);
+            p->size = sizeOf(p->left) + sizeOf(p->right) + 1;
+            p->height = (lh > rh ? lh : rh) + 1;
+        }
+
+        // 旋转只会改动插入路径上刚复制出来的结点，旧版本不受影响
+        static void rotateLeft(BTNode*& k2) {
+            BTNode* k1 = k2->right;
+            k2->right = k1->left;
+            k1->left = k2;
+            pull(k2);
+            pull(k1);
+            k2 = k1;
+        }
+
+        static void rotateRight(BTNode*& k2) {
+            BTNode* k1 = k2->left;
+            k2->left = k1->right;
+            k1->right = k2;
+            pull(k2);
+            pull(k1);
+            k2 = k1;
+        }
+
+        // 沿查找路径逐层复制；失衡判断、旋转类型与 AVL::insert 一致
+        BTNode* insert_(const BTNode* t, int key) {
+            BTNode* p = pool.alloc();
+            if (!p) return nullptr;
+            if (!t) {
+                p->key = key;
+                p->left = p->right = nullptr;
+                p->size = 1;
+                p->height = 1;
+                return p;
+            }
+            *p = *t;
+
+            if (key < t->key) {
+                p->left = insert_(t->left, key);
+                if (!p->left) return nullptr;
+                if (AVL::balanceFactor(p) == 2) {
+                    BTNode* y = p->left;
+                    if (key < y->key) {
+                        rotationRecords_.push_back({RotationRecord::LL, p, y, y->left});
+                        rotateRight(p);
+                    } else {
+                        rotationRecords_.push_back({RotationRecord::LR, p, y, y->right});
+                        rotateLeft(p->left);
+                        rotateRight(p);
+                    }
+                }
+            } else {
+                p->right = insert_(t->right, key);
+                if (!p->right) return nullptr;
+                if (AVL::balanceFactor(p) == -2) {
+                    BTNode* y = p->right;
+                    if (key > y->key) {
+                        rotationRecords_.push_back({RotationRecord::RR, p, y, y->right});
+                        rotateLeft(p);
+                    } else {
+                        rotationRecords_.push_back({RotationRecord::RL, p, y, y->left});
+                        rotateRight(p->right);
+                        rotateLeft(p);
+                    }
+                }
+            }
+            pull(p);
+            return p;
+        }
+    };
+
+} // namespace ds
+
+#endif // PERSISTENTAVL_H
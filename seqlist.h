@@ -6,89 +6,319 @@
 #define SEQLIST_H
 
 #include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "simdkernels.h"
 
 namespace ds {
+    // 顺序表模板：
+    // - 平凡可复制类型（int、POD 结构体等）扩容走 realloc，插入/删除走 memmove 整块搬移；
+    // - 其它类型扩容时逐个移动构造到新缓冲区，插入/删除用移动赋值挪位。
+    template <typename T>
     class Seqlist {
-        int *a;   // 头指针
+        static constexpr bool kTrivial = std::is_trivially_copyable_v<T>;
+
+        T *a;     // 头指针
         int n;    // 元素个数
         int cap;  // 容量
 
-        // 扩容到至少 want 个元素
-        void grow(int want) {
+        // 把容量调整为恰好 c（c >= n），失败时保持原状
+        bool reallocTo(int c) {
+            if constexpr (kTrivial) {
+                void *p = std::realloc(a, sizeof(T) * static_cast<std::size_t>(c));
+                if (!p) return false; // realloc 失败时原块仍然有效
+                a = static_cast<T*>(p);
+            } else {
+                T *p = static_cast<T*>(std::malloc(sizeof(T) * static_cast<std::size_t>(c)));
+                if (!p) return false;
+
+                for (int i = 0; i < n; ++i) {
+                    ::new (static_cast<void*>(p + i)) T(std::move(a[i]));
+                    a[i].~T();
+                }
+                if (a) std::free(a);
+                a = p;
+            }
+            cap = c;
+            return true;
+        }
+
+        // 扩容到至少 want 个元素（按倍数增长）；申请失败返回 false，保持原状
+        bool grow(int want) {
             int c = (cap > 0) ? cap * 2 : 8;
             if (c < want) c = want;
+            return reallocTo(c);
+        }
 
-            int *p = static_cast<int*>(std::malloc(sizeof(int) * c));
-            if (!p) return; // 申请失败，保持原状
+        // src 是否指向本表的缓冲区（批量插入自身的一段时需要先拷出来）
+        bool aliases(const T *src) const {
+            return a && src >= a && src < a + cap;
+        }
 
-            for (int i = 0; i < n; ++i) {
-                p[i] = a[i];
+        // 把 [position, n) 整体右移一格，空出 position（调用前保证 n < cap）
+        void shiftRight(int position) {
+            if constexpr (kTrivial) {
+                std::memmove(a + position + 1, a + position,
+                             sizeof(T) * static_cast<std::size_t>(n - position));
+            } else {
+                if (position == n) return;
+                ::new (static_cast<void*>(a + n)) T(std::move(a[n - 1]));
+                for (int i = n - 1; i > position; --i) {
+                    a[i] = std::move(a[i - 1]);
+                }
+                a[position].~T();
             }
-            if (a) std::free(a);
-            a  = p;
-            cap = c;
+        }
+
+        // 在 position 放入一个元素（value 已是独立的临时量，不会与表内元素重叠）
+        bool emplaceAt(int position, T &&value) {
+            if (position < 0 || position > n) return false;
+
+            if (n + 1 > cap && !grow(n + 1)) return false;
+
+            shiftRight(position);
+            ::new (static_cast<void*>(a + position)) T(std::move(value));
+            ++n;
+            return true;
         }
 
     public:
         Seqlist() : a(nullptr), n(0), cap(0) {}
 
         ~Seqlist() {
+            clear();
             if (a) std::free(a);
         }
 
+        // 持有裸缓冲区，禁止浅拷贝
+        Seqlist(const Seqlist&) = delete;
+        Seqlist& operator=(const Seqlist&) = delete;
+
         // 元素个数
         int size() const { return n; }
 
         // 容量
         int capacity() const { return cap; }
 
-        // 在 position 位置插入一个元素（0..n），成功返回 true
-        bool insert(int position, int value) {
-            if (position < 0 || position > n) return false;
+        // 只读的连续存储首地址（供批量读取，长度为 size()）
+        const T* data() const { return a; }
 
-            if (n + 1 > cap) {
-                grow(n + 1);
-            }
-            if (n + 1 > cap) {
-                // grow 失败
-                return false;
-            }
+        // 在 position 位置插入一个元素（0..n），成功返回 true
+        bool insert(int position, const T &value) {
+            // 先拷贝出来：value 可能引用表内元素，扩容/搬移后会失效
+            T tmp(value);
+            return emplaceAt(position, std::move(tmp));
+        }
 
-            // 从尾部开始右移
-            for (int i = n; i > position; --i) {
-                a[i] = a[i - 1];
-            }
-            a[position] = value;
-            ++n;
-            return true;
+        bool insert(int position, T &&value) {
+            T tmp(std::move(value));
+            return emplaceAt(position, std::move(tmp));
         }
 
         // 删除 position 位置元素（0..n-1），成功返回 true
         bool erase(int position) {
             if (position < 0 || position >= n) return false;
 
-            for (int i = position; i < n - 1; ++i) {
-                a[i] = a[i + 1];
+            if constexpr (kTrivial) {
+                std::memmove(a + position, a + position + 1,
+                             sizeof(T) * static_cast<std::size_t>(n - position - 1));
+            } else {
+                for (int i = position; i < n - 1; ++i) {
+                    a[i] = std::move(a[i + 1]);
+                }
+                a[n - 1].~T();
             }
             --n;
             return true;
         }
 
-        // 获取 position 位置元素，不合法返回 0
-        int get(int position) const {
-            if (position < 0 || position >= n) return 0;
+        // 获取 position 位置元素，不合法返回 T{}（int 时即 0）
+        T get(int position) const {
+            if (position < 0 || position >= n) return T{};
             return a[position];
         }
 
         // 修改 position 位置元素，成功返回 true
-        bool set(int position, int value) {
+        bool set(int position, const T &value) {
             if (position < 0 || position >= n) return false;
             a[position] = value;
             return true;
         }
 
+        // 预留至少 want 个元素的容量（只增不减），成功返回 true
+        bool reserve(int want) {
+            if (want <= cap) return true;
+            return reallocTo(want);
+        }
+
+        // 用 [first, last) 整体替换表内容：一次预留、一次拷贝
+        template <typename It>
+        bool assign(It first, It last) {
+            clear();
+            using Cat = typename std::iterator_traits<It>::iterator_category;
+            if constexpr (std::is_base_of_v<std::forward_iterator_tag, Cat>) {
+                const auto cnt = std::distance(first, last);
+                if (cnt <= 0) return true;
+                if (!reserve(static_cast<int>(cnt))) return false;
+
+                if constexpr (kTrivial && std::contiguous_iterator<It>) {
+                    std::memcpy(a, std::to_address(first), sizeof(T) * static_cast<std::size_t>(cnt));
+                    n = static_cast<int>(cnt);
+                } else {
+                    for (; first != last; ++first, ++n) {
+                        ::new (static_cast<void*>(a + n)) T(*first);
+                    }
+                }
+                return true;
+            } else {
+                // 单趟迭代器无法预知长度，只能逐个追加
+                for (; first != last; ++first) {
+                    if (!insert(n, *first)) return false;
+                }
+                return true;
+            }
+        }
+
+        // 在 position 处整体插入一段元素（0..n）：尾部只挪动一次
+        bool insert_range(int position, std::span<const T> src) {
+            if (position < 0 || position > n) return false;
+            const int k = static_cast<int>(src.size());
+            if (k == 0) return true;
+
+            if (aliases(src.data())) {
+                // 插入自身的一段：先拷到临时表，避免扩容/挪位后读到脏数据
+                Seqlist tmp;
+                if (!tmp.assign(src.begin(), src.end())) return false;
+                return insert_range(position, std::span<const T>(tmp.a, static_cast<std::size_t>(tmp.n)));
+            }
+
+            if (n + k > cap && !grow(n + k)) return false;
+
+            if constexpr (kTrivial) {
+                std::memmove(a + position + k, a + position,
+                             sizeof(T) * static_cast<std::size_t>(n - position));
+                std::memcpy(a + position, src.data(), sizeof(T) * static_cast<std::size_t>(k));
+            } else {
+                // 从尾部往前挪 k 格：落到未构造区域的用移动构造，其余用移动赋值
+                for (int i = n - 1; i >= position; --i) {
+                    const int dst = i + k;
+                    if (dst >= n) ::new (static_cast<void*>(a + dst)) T(std::move(a[i]));
+                    else a[dst] = std::move(a[i]);
+                }
+                for (int j = 0; j < k; ++j) {
+                    const int dst = position + j;
+                    if (dst < n) a[dst] = src[static_cast<std::size_t>(j)];
+                    else ::new (static_cast<void*>(a + dst)) T(src[static_cast<std::size_t>(j)]);
+                }
+            }
+            n += k;
+            return true;
+        }
+
+        // 在表尾追加一段元素
+        bool append_span(std::span<const T> src) {
+            return insert_range(n, src);
+        }
+
+        // 删除从 position 开始的 count 个元素（position + count <= n），成功返回 true
+        bool erase_range(int position, int count) {
+            if (position < 0 || count < 0 || position > n || count > n - position) return false;
+            if (count == 0) return true;
+
+            if constexpr (kTrivial) {
+                std::memmove(a + position, a + position + count,
+                             sizeof(T) * static_cast<std::size_t>(n - position - count));
+            } else {
+                for (int i = position; i + count < n; ++i) {
+                    a[i] = std::move(a[i + count]);
+                }
+                for (int i = n - count; i < n; ++i) a[i].~T();
+            }
+            n -= count;
+            return true;
+        }
+
+        // ========== 只读查询：直接扫连续存储，int 走 SIMD 内核 ==========
+
+        // 第一个等于 value 的下标，找不到返回 -1
+        int find(const T &value) const {
+            if constexpr (std::is_same_v<T, int>) {
+                return simd::findInt(a, n, value);
+            } else {
+                for (int i = 0; i < n; ++i) if (a[i] == value) return i;
+                return -1;
+            }
+        }
+
+        // 等于 value 的元素个数
+        int count(const T &value) const {
+            if constexpr (std::is_same_v<T, int>) {
+                return simd::countInt(a, n, value);
+            } else {
+                int c = 0;
+                for (int i = 0; i < n; ++i) if (a[i] == value) ++c;
+                return c;
+            }
+        }
+
+        // 最小值/最大值，空表返回 false
+        bool min(T *out) const {
+            if constexpr (std::is_same_v<T, int>) {
+                return simd::minMaxInt(a, n, out, nullptr);
+            } else {
+                if (n <= 0) return false;
+                int k = 0;
+                for (int i = 1; i < n; ++i) if (a[i] < a[k]) k = i;
+                if (out) *out = a[k];
+                return true;
+            }
+        }
+
+        bool max(T *out) const {
+            if constexpr (std::is_same_v<T, int>) {
+                return simd::minMaxInt(a, n, nullptr, out);
+            } else {
+                if (n <= 0) return false;
+                int k = 0;
+                for (int i = 1; i < n; ++i) if (a[k] < a[i]) k = i;
+                if (out) *out = a[k];
+                return true;
+            }
+        }
+
+        // 元素和：整数类型用 long long 累加，浮点用 double
+        auto sum() const {
+            static_assert(std::is_arithmetic_v<T>, "Seqlist::sum requires an arithmetic element type");
+            using Acc = std::conditional_t<std::is_integral_v<T>, long long, double>;
+            if constexpr (std::is_same_v<T, int>) {
+                return static_cast<Acc>(simd::sumInt(a, n));
+            } else {
+                Acc s = 0;
+                for (int i = 0; i < n; ++i) s += static_cast<Acc>(a[i]);
+                return s;
+            }
+        }
+
+        // 第一个大于 threshold 的下标，找不到返回 -1
+        int find_if_greater(const T &threshold) const {
+            if constexpr (std::is_same_v<T, int>) {
+                return simd::findGreaterInt(a, n, threshold);
+            } else {
+                for (int i = 0; i < n; ++i) if (threshold < a[i]) return i;
+                return -1;
+            }
+        }
+
         // 清空顺序表（不释放容量）
         void clear() {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                for (int i = 0; i < n; ++i) a[i].~T();
+            }
             n = 0;
         }
     };
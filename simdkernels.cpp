@@ -0,0 +1,337 @@
+//
+// Created by xiang on 26-10-17.
+//
+
+#include "simdkernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DS_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang 需要给单个函数打 target 属性才能在默认编译选项下使用 AVX2；MSVC 不需要
+#if defined(__GNUC__) || defined(__clang__)
+#define DS_TARGET(x) __attribute__((target(x)))
+#else
+#define DS_TARGET(x)
+#endif
+
+namespace ds::simd {
+
+namespace {
+
+// ==================== 标量版本（任何平台都可用） ====================
+int findScalar(const int* a, int n, int v) {
+    for (int i = 0; i < n; ++i) if (a[i] == v) return i;
+    return -1;
+}
+
+int countScalar(const int* a, int n, int v) {
+    int c = 0;
+    for (int i = 0; i < n; ++i) c += (a[i] == v);
+    return c;
+}
+
+bool minMaxScalar(const int* a, int n, int* mn, int* mx) {
+    if (n <= 0) return false;
+    int lo = a[0], hi = a[0];
+    for (int i = 1; i < n; ++i) {
+        if (a[i] < lo) lo = a[i];
+        if (a[i] > hi) hi = a[i];
+    }
+    if (mn) *mn = lo;
+    if (mx) *mx = hi;
+    return true;
+}
+
+long long sumScalar(const int* a, int n) {
+    long long s = 0;
+    for (int i = 0; i < n; ++i) s += a[i];
+    return s;
+}
+
+int findGreaterScalar(const int* a, int n, int threshold) {
+    for (int i = 0; i < n; ++i) if (a[i] > threshold) return i;
+    return -1;
+}
+
+#ifdef DS_SIMD_X86
+
+inline int lowestBit(unsigned m) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long idx;
+    _BitScanForward(&idx, m);
+    return static_cast<int>(idx);
+#else
+    return __builtin_ctz(m);
+#endif
+}
+
+inline int popCount(unsigned m) {
+    int c = 0;
+    while (m) { m &= m - 1; ++c; }
+    return c;
+}
+
+// ==================== SSE4.2 版本：一次 4 个 int ====================
+DS_TARGET("sse4.2")
+int findSSE(const int* a, int n, int v) {
+    const __m128i key = _mm_set1_epi32(v);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        unsigned m = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, key))));
+        if (m) return i + lowestBit(m);
+    }
+    for (; i < n; ++i) if (a[i] == v) return i;
+    return -1;
+}
+
+DS_TARGET("sse4.2")
+int countSSE(const int* a, int n, int v) {
+    const __m128i key = _mm_set1_epi32(v);
+    __m128i acc = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        acc = _mm_sub_epi32(acc, _mm_cmpeq_epi32(x, key)); // 相等时掩码为 -1
+    }
+    alignas(16) int lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    int c = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; i < n; ++i) c += (a[i] == v);
+    return c;
+}
+
+DS_TARGET("sse4.2")
+bool minMaxSSE(const int* a, int n, int* mn, int* mx) {
+    if (n < 4) return minMaxScalar(a, n, mn, mx);
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+    __m128i hi = lo;
+    int i = 4;
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        lo = _mm_min_epi32(lo, x);
+        hi = _mm_max_epi32(hi, x);
+    }
+    alignas(16) int l[4], h[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(l), lo);
+    _mm_store_si128(reinterpret_cast<__m128i*>(h), hi);
+    int rlo = l[0], rhi = h[0];
+    for (int k = 1; k < 4; ++k) {
+        if (l[k] < rlo) rlo = l[k];
+        if (h[k] > rhi) rhi = h[k];
+    }
+    for (; i < n; ++i) {
+        if (a[i] < rlo) rlo = a[i];
+        if (a[i] > rhi) rhi = a[i];
+    }
+    if (mn) *mn = rlo;
+    if (mx) *mx = rhi;
+    return true;
+}
+
+DS_TARGET("sse4.2")
+long long sumSSE(const int* a, int n) {
+    __m128i acc = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        acc = _mm_add_epi64(acc, _mm_cvtepi32_epi64(x));
+        acc = _mm_add_epi64(acc, _mm_cvtepi32_epi64(_mm_srli_si128(x, 8)));
+    }
+    alignas(16) long long lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    long long s = lanes[0] + lanes[1];
+    for (; i < n; ++i) s += a[i];
+    return s;
+}
+
+DS_TARGET("sse4.2")
+int findGreaterSSE(const int* a, int n, int threshold) {
+    const __m128i t = _mm_set1_epi32(threshold);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        unsigned m = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(x, t))));
+        if (m) return i + lowestBit(m);
+    }
+    for (; i < n; ++i) if (a[i] > threshold) return i;
+    return -1;
+}
+
+// ==================== AVX2 版本：一次 8 个 int ====================
+DS_TARGET("avx2")
+int findAVX2(const int* a, int n, int v) {
+    const __m256i key = _mm256_set1_epi32(v);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        unsigned m = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(x, key))));
+        if (m) return i + lowestBit(m);
+    }
+    for (; i < n; ++i) if (a[i] == v) return i;
+    return -1;
+}
+
+DS_TARGET("avx2")
+int countAVX2(const int* a, int n, int v) {
+    const __m256i key = _mm256_set1_epi32(v);
+    int i = 0, c = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        c += popCount(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(x, key)))));
+    }
+    for (; i < n; ++i) c += (a[i] == v);
+    return c;
+}
+
+DS_TARGET("avx2")
+bool minMaxAVX2(const int* a, int n, int* mn, int* mx) {
+    if (n < 8) return minMaxScalar(a, n, mn, mx);
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+    __m256i hi = lo;
+    int i = 8;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        lo = _mm256_min_epi32(lo, x);
+        hi = _mm256_max_epi32(hi, x);
+    }
+    alignas(32) int l[8], h[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(l), lo);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(h), hi);
+    int rlo = l[0], rhi = h[0];
+    for (int k = 1; k < 8; ++k) {
+        if (l[k] < rlo) rlo = l[k];
+        if (h[k] > rhi) rhi = h[k];
+    }
+    for (; i < n; ++i) {
+        if (a[i] < rlo) rlo = a[i];
+        if (a[i] > rhi) rhi = a[i];
+    }
+    if (mn) *mn = rlo;
+    if (mx) *mx = rhi;
+    return true;
+}
+
+DS_TARGET("avx2")
+long long sumAVX2(const int* a, int n) {
+    __m256i acc = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1)));
+    }
+    alignas(32) long long lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    long long s = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; i < n; ++i) s += a[i];
+    return s;
+}
+
+DS_TARGET("avx2")
+int findGreaterAVX2(const int* a, int n, int threshold) {
+    const __m256i t = _mm256_set1_epi32(threshold);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        unsigned m = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(x, t))));
+        if (m) return i + lowestBit(m);
+    }
+    for (; i < n; ++i) if (a[i] > threshold) return i;
+    return -1;
+}
+
+#if defined(_MSC_VER) && !defined(__clang__)
+// MSVC 没有 __builtin_cpu_supports，自己读 CPUID；AVX2 还要确认操作系统保存了 YMM 寄存器
+Level probe() {
+    int r[4];
+    __cpuid(r, 0);
+    const int maxLeaf = r[0];
+    if (maxLeaf < 1) return Level::Scalar;
+    __cpuid(r, 1);
+    const bool sse42   = (r[2] >> 20) & 1;
+    const bool osxsave = (r[2] >> 27) & 1;
+    const bool avx     = (r[2] >> 28) & 1;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(r, 7, 0);
+        if ((r[1] >> 5) & 1) return Level::AVX2;
+    }
+    return sse42 ? Level::SSE42 : Level::Scalar;
+}
+#else
+Level probe() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return Level::AVX2;
+    if (__builtin_cpu_supports("sse4.2")) return Level::SSE42;
+    return Level::Scalar;
+}
+#endif
+
+#else  // 非 x86：只有标量版本
+Level probe() { return Level::Scalar; }
+#endif // DS_SIMD_X86
+
+// 一组内核函数指针，按档位切换
+struct Table {
+    int  (*find)(const int*, int, int);
+    int  (*count)(const int*, int, int);
+    bool (*minMax)(const int*, int, int*, int*);
+    long long (*sum)(const int*, int);
+    int  (*findGreater)(const int*, int, int);
+};
+
+Table tableFor(Level lv) {
+#ifdef DS_SIMD_X86
+    if (lv == Level::AVX2)  return { findAVX2, countAVX2, minMaxAVX2, sumAVX2, findGreaterAVX2 };
+    if (lv == Level::SSE42) return { findSSE,  countSSE,  minMaxSSE,  sumSSE,  findGreaterSSE };
+#else
+    (void)lv;
+#endif
+    return { findScalar, countScalar, minMaxScalar, sumScalar, findGreaterScalar };
+}
+
+struct Dispatch {
+    Level best;
+    Level cur;
+    Table t;
+    Dispatch() : best(probe()), cur(best), t(tableFor(best)) {}
+};
+
+// 首次调用时探测 CPU（函数内静态变量，线程安全初始化）
+Dispatch& dispatch() {
+    static Dispatch d;
+    return d;
+}
+
+} // namespace
+
+Level detected() { return dispatch().best; }
+Level active()   { return dispatch().cur; }
+
+void forceLevel(Level lv) {
+    Dispatch& d = dispatch();
+    if (static_cast<int>(lv) > static_cast<int>(d.best)) lv = d.best;
+    d.cur = lv;
+    d.t = tableFor(lv);
+}
+
+const char* levelName(Level lv) {
+    switch (lv) {
+    case Level::AVX2:  return "AVX2";
+    case Level::SSE42: return "SSE4.2";
+    default:           return "scalar";
+    }
+}
+
+int findInt(const int* a, int n, int v)                 { return (a && n > 0) ? dispatch().t.find(a, n, v) : -1; }
+int countInt(const int* a, int n, int v)                { return (a && n > 0) ? dispatch().t.count(a, n, v) : 0; }
+bool minMaxInt(const int* a, int n, int* mn, int* mx)   { return (a && n > 0) ? dispatch().t.minMax(a, n, mn, mx) : false; }
+long long sumInt(const int* a, int n)                   { return (a && n > 0) ? dispatch().t.sum(a, n) : 0; }
+int findGreaterInt(const int* a, int n, int threshold)  { return (a && n > 0) ? dispatch().t.findGreater(a, n, threshold) : -1; }
+
+} // namespace ds::simd
@@ -0,0 +1,33 @@
+//
+// Created by xiang on 26-10-17.
+//
+
+#ifndef SIMDKERNELS_H
+#define SIMDKERNELS_H
+
+namespace ds::simd {
+
+    // 指令集档位：运行时按 CPU 能力自动选择最高档，也可以手动压低（用于基准对比）
+    enum class Level { Scalar, SSE42, AVX2 };
+
+    Level detected();            // CPU 实际支持的最高档
+    Level active();              // 当前使用的档位
+    void  forceLevel(Level lv);  // 强制使用某一档（不会超过 detected()）
+    const char* levelName(Level lv);
+
+    // 以下内核都作用在连续的 int 数组 a[0..n) 上
+
+    // 第一个等于 v 的下标，找不到返回 -1
+    int findInt(const int* a, int n, int v);
+    // 等于 v 的元素个数
+    int countInt(const int* a, int n, int v);
+    // 最小值/最大值，n<=0 时返回 false
+    bool minMaxInt(const int* a, int n, int* mn, int* mx);
+    // 元素和（64 位累加，不会溢出）
+    long long sumInt(const int* a, int n);
+    // 第一个大于 threshold 的下标，找不到返回 -1
+    int findGreaterInt(const int* a, int n, int threshold);
+
+} // namespace ds::simd
+
+#endif // SIMDKERNELS_H
@@ -0,0 +1,220 @@
+//
+// Created by xiang on 26-10-17.
+//
+
+#ifndef UNROLLEDLINKLIST_H
+#define UNROLLEDLINKLIST_H
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include "nodepool.h"
+
+namespace ds {
+
+    // 块状链表（unrolled linked list）：每个结点是一块，块里顺序存放若干个值。
+    // 块大小 = CacheLines 条缓存行（默认 1 条，64 字节），并按缓存行对齐；
+    // 按位置插入/删除只改动一块（满了对半拆分，过空时和后继合并），
+    // 遍历时大部分读取都落在同一条缓存行里。对外接口与 ds::Linklist 一致。
+    template <int CacheLines = 1>
+    class UnrolledLinklist {
+    public:
+        static constexpr int kLineBytes = 64;
+        static constexpr int kBlockCap =
+            static_cast<int>((kLineBytes * CacheLines - sizeof(void*) - sizeof(int)) / sizeof(int));
+
+        struct alignas(kLineBytes) Block {
+            Block *next;
+            int count;               // 本块已用个数
+            int values[kBlockCap];
+        };
+        static_assert(sizeof(Block) == static_cast<std::size_t>(kLineBytes * CacheLines),
+                      "block must occupy exactly CacheLines cache lines");
+
+    private:
+        Block *head;
+        Block *tail;
+        int length;
+        int blocks;
+        NodePool<Block, 64> pool;
+
+        Block* newBlock() {
+            Block *b = pool.alloc();
+            if (!b) return nullptr;
+            b->next = nullptr;
+            b->count = 0;
+            ++blocks;
+            return b;
+        }
+
+        void dropBlock(Block *b) {
+            pool.release(b);
+            --blocks;
+        }
+
+        // 在 b 后面拆出一块，把 b 的后半部分挪过去；失败返回 nullptr
+        Block* split(Block *b) {
+            Block *nb = newBlock();
+            if (!nb) return nullptr;
+            const int keep = b->count / 2;
+            nb->count = b->count - keep;
+            std::memcpy(nb->values, b->values + keep, sizeof(int) * static_cast<std::size_t>(nb->count));
+            b->count = keep;
+            nb->next = b->next;
+            b->next = nb;
+            if (tail == b) tail = nb;
+            return nb;
+        }
+
+    public:
+        UnrolledLinklist() : head(nullptr), tail(nullptr), length(0), blocks(0) {}
+
+        ~UnrolledLinklist() {
+            clear();
+        }
+
+        UnrolledLinklist(const UnrolledLinklist&) = delete;
+        UnrolledLinklist& operator=(const UnrolledLinklist&) = delete;
+
+        // 长度
+        int size() const { return length; }
+
+        // 块数 / 每块容量（画图、统计内存用）
+        int blockCount() const { return blocks; }
+        static constexpr int blockCapacity() { return kBlockCap; }
+
+        // 结点占用的字节数（不含结点池的块头）
+        std::size_t memoryBytes() const { return static_cast<std::size_t>(blocks) * sizeof(Block); }
+
+        // 只读首块
+        const Block* firstBlock() const { return head; }
+
+        // 清空：块全部还给结点池
+        void clear() {
+            pool.reset();
+            head = tail = nullptr;
+            length = 0;
+            blocks = 0;
+        }
+
+        // 在 position 位置插入（0 <= position <= length）
+        // position <= 0 视为头插；position >= length 视为尾插
+        bool insert(int position, int value) {
+            if (position < 0) position = 0;
+            if (position > length) position = length;
+
+            if (!head) {
+                head = tail = newBlock();
+                if (!head) return false;
+            }
+
+            // 找到插入所在块：position 落在块边界时优先放进前一块的末尾
+            Block *b = head;
+            int off = position;
+            if (position == length) {
+                b = tail;
+                off = tail->count;
+            } else {
+                while (off > b->count) { off -= b->count; b = b->next; }
+            }
+
+            if (b->count == kBlockCap) {
+                if (off == kBlockCap) {
+                    // 追加在满块末尾（典型是尾插）：直接接一块新块，不拆分，块保持满载
+                    Block *nb = newBlock();
+                    if (!nb) return false;
+                    nb->next = b->next;
+                    b->next = nb;
+                    if (tail == b) tail = nb;
+                    b = nb;
+                    off = 0;
+                } else {
+                    Block *nb = split(b);
+                    if (!nb) return false;
+                    if (off > b->count) { off -= b->count; b = nb; }
+                }
+            }
+
+            std::memmove(b->values + off + 1, b->values + off,
+                         sizeof(int) * static_cast<std::size_t>(b->count - off));
+            b->values[off] = value;
+            ++b->count;
+            ++length;
+            return true;
+        }
+
+        void push_front(int value) { insert(0, value); }
+        void push_back(int value) { insert(length, value); }
+
+        // 删除 position 位置的值（0..length-1）
+        bool erase(int position) {
+            if (position < 0 || position >= length || !head) return false;
+
+            Block *prev = nullptr;
+            Block *b = head;
+            int off = position;
+            while (off >= b->count) { off -= b->count; prev = b; b = b->next; }
+
+            std::memmove(b->values + off, b->values + off + 1,
+                         sizeof(int) * static_cast<std::size_t>(b->count - off - 1));
+            --b->count;
+            --length;
+
+            if (b->count == 0) {
+                // 整块空了：摘掉
+                if (prev) prev->next = b->next;
+                else head = b->next;
+                if (tail == b) tail = prev;
+                dropBlock(b);
+            } else if (b->next && b->count < kBlockCap / 2 && b->count + b->next->count <= kBlockCap) {
+                // 过空：把后继并进来，保持块的填充率
+                Block *nx = b->next;
+                std::memcpy(b->values + b->count, nx->values, sizeof(int) * static_cast<std::size_t>(nx->count));
+                b->count += nx->count;
+                b->next = nx->next;
+                if (tail == nx) tail = b;
+                dropBlock(nx);
+            }
+            return true;
+        }
+
+        // 获取 position 位置的值，不合法返回 0（按块跳，O(n / 块容量)）
+        int get(int position) const {
+            if (position < 0 || position >= length) return 0;
+            const Block *b = head;
+            while (position >= b->count) { position -= b->count; b = b->next; }
+            return b->values[position];
+        }
+
+        // 只读前向迭代器：块内顺序读，块尾跳到下一块
+        class const_iterator {
+            const Block *b;
+            int i;
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = int;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = const int*;
+            using reference         = const int&;
+
+            const_iterator() : b(nullptr), i(0) {}
+            const_iterator(const Block *blk, int idx) : b(blk), i(idx) {}
+
+            reference operator*() const { return b->values[i]; }
+            pointer operator->() const { return &b->values[i]; }
+            const_iterator& operator++() {
+                if (++i >= b->count) { b = b->next; i = 0; }
+                return *this;
+            }
+            const_iterator operator++(int) { const_iterator t = *this; ++*this; return t; }
+            bool operator==(const const_iterator& o) const { return b == o.b && i == o.i; }
+            bool operator!=(const const_iterator& o) const { return !(*this == o); }
+        };
+
+        const_iterator begin() const { return const_iterator(head, 0); }
+        const_iterator end() const { return const_iterator(nullptr, 0); }
+    };
+
+} // namespace ds
+
+#endif // UNROLLEDLINKLIST_H